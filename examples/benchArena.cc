@@ -0,0 +1,145 @@
+/*
+ * This file is part of pex_exceptions.
+ *
+ * Developed for the LSST Data Management System.
+ * This product includes software developed by the LSST Project
+ * (https://www.lsst.org).
+ * See the COPYRIGHT file at the top-level directory of this distribution
+ * for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Measure the heap allocations and latency of creating, throwing and destroying exceptions.
+ *
+ * The program replaces the global operator new to count the allocations made per exception, and
+ * reports, for each scenario, the allocations and the time per exception:
+ *
+ *  - create: construct and destroy an exception without throwing it;
+ *  - throw: throw an exception, add a message to it in an intermediate frame, and catch it;
+ *  - handoff: create exceptions on one thread and destroy them on another, as when an exception
+ *    is carried across threads in a std::exception_ptr.
+ *
+ * The shared payload, message and formatted text of an exception are drawn from per-thread caches of
+ * free blocks unless the library was built with -DLSST_EXCEPT_NO_ARENA; build it both ways to compare.
+ * The Traceback vector and the tracepoint messages always use the global allocator, so the "throw"
+ * scenario's added message is counted either way.
+ *
+ * Usage: benchArena [iterations]
+ */
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <exception>
+#include <iostream>
+#include <new>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "boost/format.hpp"
+
+#include "lsst/pex/exceptions/Runtime.h"
+
+namespace pexExcept = lsst::pex::exceptions;
+
+namespace {
+std::atomic<long> allocations(0);
+std::string const MESSAGE = "no calibration found for the requested detector";
+}  // namespace
+
+// The replacements are kept out of line, so that the compiler does not see std::malloc and std::free
+// through them and warn that the pointers they handle come from mismatched allocation functions.
+__attribute__((noinline)) void* operator new(std::size_t size) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* pointer = std::malloc(size ? size : 1)) return pointer;
+    throw std::bad_alloc();
+}
+
+__attribute__((noinline)) void operator delete(void* pointer) noexcept { std::free(pointer); }
+
+__attribute__((noinline)) void operator delete(void* pointer, std::size_t) noexcept { std::free(pointer); }
+
+__attribute__((noinline)) void lookup(int) {
+    throw LSST_EXCEPT(pexExcept::NotFoundError, MESSAGE);
+}
+
+__attribute__((noinline)) void process(int key) {
+    try {
+        lookup(key);
+    } catch (pexExcept::NotFoundError& e) {
+        LSST_EXCEPT_ADD(e, "while processing the visit for this detector");
+        throw;
+    }
+}
+
+struct Result {
+    double ns;
+    double allocations;
+};
+
+template <typename F>
+Result measure(F func, int nIter) {
+    for (int i = 0; i < nIter / 100 + 1; ++i) func();  // warm up the caches
+    long before = allocations.load();
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < nIter; ++i) func();
+    auto stop = std::chrono::steady_clock::now();
+    return {std::chrono::duration<double, std::nano>(stop - start).count() / nIter,
+            static_cast<double>(allocations.load() - before) / nIter};
+}
+
+// Create exceptions on this thread and destroy them on another, in batches.
+Result handoff(int nIter) {
+    int const batch = 64;
+    std::vector<std::exception_ptr> pending;
+    pending.reserve(batch);
+    long before = allocations.load();
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < nIter; i += batch) {
+        for (int j = 0; j < batch; ++j) {
+            pending.push_back(std::make_exception_ptr(LSST_EXCEPT(pexExcept::NotFoundError, MESSAGE)));
+        }
+        std::thread([&pending]() { pending.clear(); }).join();
+    }
+    auto stop = std::chrono::steady_clock::now();
+    int const n = (nIter + batch - 1) / batch * batch;
+    return {std::chrono::duration<double, std::nano>(stop - start).count() / n,
+            static_cast<double>(allocations.load() - before) / n};
+}
+
+int main(int argc, char** argv) {
+    int const nIter = argc > 1 ? std::atoi(argv[1]) : 200000;
+    std::cout << boost::format("%10s %14s %12s\n") % "scenario" % "allocations" % "ns";
+    Result create = measure(
+            []() {
+                pexExcept::NotFoundError error = LSST_EXCEPT(pexExcept::NotFoundError, MESSAGE);
+            },
+            nIter);
+    std::cout << boost::format("%10s %14.2f %12.1f\n") % "create" % create.allocations % create.ns;
+    Result thrown = measure(
+            []() {
+                try {
+                    process(0);
+                } catch (pexExcept::Exception const&) {
+                }
+            },
+            nIter);
+    std::cout << boost::format("%10s %14.2f %12.1f\n") % "throw" % thrown.allocations % thrown.ns;
+    Result moved = handoff(nIter / 10);
+    std::cout << boost::format("%10s %14.2f %12.1f\n") % "handoff" % moved.allocations % moved.ns;
+    return 0;
+}
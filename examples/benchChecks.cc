@@ -0,0 +1,122 @@
+/*
+ * This file is part of pex_exceptions.
+ *
+ * Developed for the LSST Data Management System.
+ * This product includes software developed by the LSST Project
+ * (https://www.lsst.org).
+ * See the COPYRIGHT file at the top-level directory of this distribution
+ * for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Compare the inline expansion of the original LSST_THROW_IF_NE with the cold-path check macros in
+ * asserts.h on a tight gather loop.
+ *
+ * The program reports throughput; the code-size difference can be read off the built binary with
+ *
+ *     nm -C --size-sort benchChecks | grep gather
+ *
+ * since each loop lives in its own non-inlined function.
+ */
+
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+#include "boost/format.hpp"
+
+#include "lsst/pex/exceptions/asserts.h"
+
+namespace pexExcept = lsst::pex::exceptions;
+
+// The expansion LSST_THROW_IF_NE had before the checks were moved out of line, generalized to any
+// comparison.
+#define LEGACY_THROW_IF(N1, OP, N2, EXC_CLASS, MSG) \
+    if ((N1)OP(N2)) throw LSST_EXCEPT(EXC_CLASS, (boost::format(MSG) % (N1) % (N2)).str())
+
+__attribute__((noinline)) double gatherLegacy(std::vector<double> const& data,
+                                              std::vector<long> const& index) {
+    double sum = 0.0;
+    long const size = data.size();
+    for (std::size_t k = 0; k != index.size(); ++k) {
+        LEGACY_THROW_IF(index[k], <, 0, pexExcept::OutOfRangeError, "Index %d is less than %d");
+        LEGACY_THROW_IF(index[k], >=, size, pexExcept::OutOfRangeError, "Index %d out of range for size %d");
+        sum += data[index[k]];
+    }
+    return sum;
+}
+
+__attribute__((noinline)) double gatherChecked(std::vector<double> const& data,
+                                               std::vector<long> const& index) {
+    double sum = 0.0;
+    long const size = data.size();
+    for (std::size_t k = 0; k != index.size(); ++k) {
+        LSST_THROW_IF_LT(index[k], 0, pexExcept::OutOfRangeError, "Index %d is less than %d");
+        LSST_THROW_IF_GE(index[k], size, pexExcept::OutOfRangeError, "Index %d out of range for size %d");
+        sum += data[index[k]];
+    }
+    return sum;
+}
+
+__attribute__((noinline)) double gatherIndex(std::vector<double> const& data,
+                                             std::vector<long> const& index) {
+    double sum = 0.0;
+    for (std::size_t k = 0; k != index.size(); ++k) {
+        LSST_CHECK_INDEX(index[k], data.size());
+        sum += data[index[k]];
+    }
+    return sum;
+}
+
+__attribute__((noinline)) double gatherUnchecked(std::vector<double> const& data,
+                                                 std::vector<long> const& index) {
+    double sum = 0.0;
+    for (std::size_t k = 0; k != index.size(); ++k) {
+        sum += data[index[k]];
+    }
+    return sum;
+}
+
+template <typename F>
+void run(char const* name, F func, std::vector<double> const& data, std::vector<long> const& index,
+         int nIter) {
+    double sum = func(data, index);  // warm up
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < nIter; ++i) {
+        sum += func(data, index);
+    }
+    auto stop = std::chrono::steady_clock::now();
+    double ns = std::chrono::duration<double, std::nano>(stop - start).count() / nIter / index.size();
+    std::cout << boost::format("%-16s %8.3f ns/element  (checksum %g)\n") % name % ns % sum;
+}
+
+int main(int argc, char** argv) {
+    std::size_t const n = argc > 1 ? std::atol(argv[1]) : 4096;
+    int const nIter = argc > 2 ? std::atoi(argv[2]) : 20000;
+    std::vector<double> data(n);
+    std::vector<long> index(n);
+    for (std::size_t i = 0; i != n; ++i) {
+        data[i] = 0.5 * i;
+        index[i] = (i * 7919) % n;
+    }
+    run("unchecked", gatherUnchecked, data, index, nIter);
+    run("legacy", gatherLegacy, data, index, nIter);
+    run("THROW_IF_LT/GE", gatherChecked, data, index, nIter);
+    run("CHECK_INDEX", gatherIndex, data, index, nIter);
+    return 0;
+}
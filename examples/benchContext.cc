@@ -0,0 +1,112 @@
+/*
+ * This file is part of pex_exceptions.
+ *
+ * Developed for the LSST Data Management System.
+ * This product includes software developed by the LSST Project
+ * (https://www.lsst.org).
+ * See the COPYRIGHT file at the top-level directory of this distribution
+ * for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Measure the cost of LSST_EXCEPT_CONTEXT on the success path, i.e. when no exception is thrown.
+ *
+ * Each case calls a small function that does the same work inside a different kind of context: none,
+ * LSST_EXCEPT_CONTEXT, a try block whose handler uses LSST_EXCEPT_ADD, and a context message formatted
+ * eagerly (the pattern LSST_EXCEPT_CONTEXT replaces).  The program reports the time per call and the
+ * overhead relative to no context, and the cost of a throw that passes through one context.
+ *
+ * Usage: benchContext [iterations]
+ */
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+#include "boost/format.hpp"
+
+#include "lsst/pex/exceptions/Context.h"
+#include "lsst/pex/exceptions/Runtime.h"
+
+namespace pexExcept = lsst::pex::exceptions;
+
+namespace {
+
+template <typename F>
+double time(F func, int nIter) {
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < nIter; ++i) {
+        func(i);
+    }
+    auto stop = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(stop - start).count() / nIter;
+}
+
+std::string const name = "calexp";
+
+__attribute__((noinline)) int work(int visit) {
+    if (visit < 0) throw LSST_EXCEPT(pexExcept::NotFoundError, "no data for visit");
+    asm volatile("" : : "r"(visit) : "memory");
+    return visit;
+}
+
+__attribute__((noinline)) int plain(int visit) { return work(visit); }
+
+__attribute__((noinline)) int guarded(int visit) {
+    return LSST_EXCEPT_CONTEXT("while processing visit %d of %s", visit, name)([&] { return work(visit); });
+}
+
+__attribute__((noinline)) int caught(int visit) {
+    try {
+        return work(visit);
+    } catch (pexExcept::NotFoundError& e) {
+        LSST_EXCEPT_ADD(e, (boost::format("while processing visit %d of %s") % visit % name).str());
+        throw;
+    }
+}
+
+__attribute__((noinline)) int eager(int visit) {
+    std::string const context = "while processing visit " + std::to_string(visit) + " of " + name;
+    asm volatile("" : : "r"(context.data()) : "memory");
+    return work(visit);
+}
+
+template <int (*function)(int)>
+void fail(int) {
+    try {
+        function(-1);
+    } catch (pexExcept::NotFoundError const&) {
+    }
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    int const nIter = argc > 1 ? std::atoi(argv[1]) : 10000000;
+    double const plainNs = time(plain, nIter);
+    std::cout << boost::format("%-28s %10s %14s %14s\n") % "context" % "ns/call" % "overhead (ns)" %
+                         "throw (ns)";
+    auto report = [&](char const* label, double callNs, double throwNs) {
+        std::cout << boost::format("%-28s %10.2f %14.2f %14.1f\n") % label % callNs % (callNs - plainNs) %
+                             throwNs;
+    };
+    report("none", plainNs, time(fail<plain>, nIter / 100));
+    report("LSST_EXCEPT_CONTEXT", time(guarded, nIter), time(fail<guarded>, nIter / 100));
+    report("try/catch + LSST_EXCEPT_ADD", time(caught, nIter), time(fail<caught>, nIter / 100));
+    report("eager std::string", time(eager, nIter), time(fail<eager>, nIter / 100));
+    return 0;
+}
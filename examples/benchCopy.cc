@@ -0,0 +1,79 @@
+/*
+ * This file is part of pex_exceptions.
+ *
+ * Developed for the LSST Data Management System.
+ * This product includes software developed by the LSST Project
+ * (https://www.lsst.org).
+ * See the COPYRIGHT file at the top-level directory of this distribution
+ * for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Measure the cost of copying and cloning exceptions as a function of traceback depth.
+ *
+ * Copies share the message and traceback, so both should be flat in the depth.
+ */
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+
+#include "boost/format.hpp"
+
+#include "lsst/pex/exceptions/Runtime.h"
+
+namespace pexExcept = lsst::pex::exceptions;
+
+template <typename F>
+double time(F func, int nIter) {
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < nIter; ++i) {
+        func();
+    }
+    auto stop = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(stop - start).count() / nIter;
+}
+
+int main(int argc, char** argv) {
+    int const nIter = argc > 1 ? std::atoi(argv[1]) : 1000000;
+    std::cout << boost::format("%8s %12s %12s %14s\n") % "depth" % "copy (ns)" % "clone (ns)" %
+                         "rethrow (ns)";
+    for (int depth : {1, 4, 16, 64, 256}) {
+        pexExcept::NotFoundError error = LSST_EXCEPT(pexExcept::NotFoundError, "lookup failed for key");
+        for (int i = 1; i < depth; ++i) {
+            LSST_EXCEPT_ADD(error, "while processing a fairly typical context message");
+        }
+        double copyNs = time(
+                [&error]() {
+                    pexExcept::NotFoundError copy(error);
+                    asm volatile("" : : "r"(&copy) : "memory");
+                },
+                nIter);
+        double cloneNs = time([&error]() { std::unique_ptr<pexExcept::Exception> p(error.clone()); },
+                              nIter);
+        double rethrowNs = time(
+                [&error]() {
+                    try {
+                        throw error;
+                    } catch (pexExcept::NotFoundError const&) {
+                    }
+                },
+                nIter / 10);
+        std::cout << boost::format("%8d %12.1f %12.1f %14.1f\n") % depth % copyNs % cloneNs % rethrowNs;
+    }
+    return 0;
+}
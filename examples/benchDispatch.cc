@@ -0,0 +1,150 @@
+/*
+ * This file is part of pex_exceptions.
+ *
+ * Developed for the LSST Data Management System.
+ * This product includes software developed by the LSST Project
+ * (https://www.lsst.org).
+ * See the COPYRIGHT file at the top-level directory of this distribution
+ * for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Compare dispatch() with a chain of dynamic_casts and with a sequence of catch clauses.
+ *
+ * Each approach routes exceptions of ten types from Runtime.h to one of seven handlers (the most
+ * derived that matches), cycling through the types; the rates are for already-created exceptions,
+ * so they measure only the routing.  The exception_ptr rows include rethrowing the exception.
+ *
+ * Usage: benchDispatch [iterations]
+ */
+
+#include <chrono>
+#include <cstdlib>
+#include <exception>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+#include "boost/format.hpp"
+
+#include "lsst/pex/exceptions/Dispatch.h"
+#include "lsst/pex/exceptions/Runtime.h"
+
+namespace pexExcept = lsst::pex::exceptions;
+
+enum class Action { RETRY, SKIP, FAIL, ABORT };
+
+__attribute__((noinline)) Action route(pexExcept::Exception const& e) {
+    return pexExcept::dispatch(
+            e, [](pexExcept::OverflowError const&) { return Action::SKIP; },
+            [](pexExcept::UnderflowError const&) { return Action::SKIP; },
+            [](pexExcept::IoError const&) { return Action::RETRY; },
+            [](pexExcept::RuntimeError const&) { return Action::FAIL; },
+            [](pexExcept::InvalidParameterError const&) { return Action::ABORT; },
+            [](pexExcept::LogicError const&) { return Action::ABORT; },
+            [](pexExcept::Exception const&) { return Action::FAIL; });
+}
+
+__attribute__((noinline)) Action routeCast(pexExcept::Exception const& e) {
+    if (dynamic_cast<pexExcept::OverflowError const*>(&e)) return Action::SKIP;
+    if (dynamic_cast<pexExcept::UnderflowError const*>(&e)) return Action::SKIP;
+    if (dynamic_cast<pexExcept::IoError const*>(&e)) return Action::RETRY;
+    if (dynamic_cast<pexExcept::RuntimeError const*>(&e)) return Action::FAIL;
+    if (dynamic_cast<pexExcept::InvalidParameterError const*>(&e)) return Action::ABORT;
+    if (dynamic_cast<pexExcept::LogicError const*>(&e)) return Action::ABORT;
+    return Action::FAIL;
+}
+
+__attribute__((noinline)) Action routePointer(std::exception_ptr const& ptr) {
+    return pexExcept::dispatch(
+            ptr, [](pexExcept::OverflowError const&) { return Action::SKIP; },
+            [](pexExcept::UnderflowError const&) { return Action::SKIP; },
+            [](pexExcept::IoError const&) { return Action::RETRY; },
+            [](pexExcept::RuntimeError const&) { return Action::FAIL; },
+            [](pexExcept::InvalidParameterError const&) { return Action::ABORT; },
+            [](pexExcept::LogicError const&) { return Action::ABORT; },
+            [](pexExcept::Exception const&) { return Action::FAIL; });
+}
+
+__attribute__((noinline)) Action routeCatch(std::exception_ptr const& ptr) {
+    try {
+        std::rethrow_exception(ptr);
+    } catch (pexExcept::OverflowError const&) {
+        return Action::SKIP;
+    } catch (pexExcept::UnderflowError const&) {
+        return Action::SKIP;
+    } catch (pexExcept::IoError const&) {
+        return Action::RETRY;
+    } catch (pexExcept::RuntimeError const&) {
+        return Action::FAIL;
+    } catch (pexExcept::InvalidParameterError const&) {
+        return Action::ABORT;
+    } catch (pexExcept::LogicError const&) {
+        return Action::ABORT;
+    } catch (pexExcept::Exception const&) {
+        return Action::FAIL;
+    }
+}
+
+template <typename Items, typename F>
+double time(Items const& items, F func, int nIter) {
+    long sum = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < nIter; ++i) {
+        sum += static_cast<int>(func(items[i % items.size()]));
+    }
+    auto stop = std::chrono::steady_clock::now();
+    if (sum < 0) std::cout << sum;  // keep the results alive
+    return std::chrono::duration<double, std::nano>(stop - start).count() / nIter;
+}
+
+// Add an exception of type T to both lists.
+template <typename T>
+void add(std::vector<std::unique_ptr<pexExcept::Exception>>& owned,
+         std::vector<std::exception_ptr>& pointers) {
+    T e = LSST_EXCEPT(T, "routing test");
+    owned.emplace_back(new T(e));
+    pointers.push_back(std::make_exception_ptr(e));
+}
+
+int main(int argc, char** argv) {
+    int const nIter = argc > 1 ? std::atoi(argv[1]) : 2000000;
+    std::vector<std::unique_ptr<pexExcept::Exception>> owned;
+    std::vector<std::exception_ptr> pointers;
+    add<pexExcept::OverflowError>(owned, pointers);
+    add<pexExcept::UnderflowError>(owned, pointers);
+    add<pexExcept::RangeError>(owned, pointers);
+    add<pexExcept::IoError>(owned, pointers);
+    add<pexExcept::RuntimeError>(owned, pointers);
+    add<pexExcept::InvalidParameterError>(owned, pointers);
+    add<pexExcept::DomainError>(owned, pointers);
+    add<pexExcept::TypeError>(owned, pointers);
+    add<pexExcept::NotFoundError>(owned, pointers);
+    add<pexExcept::Exception>(owned, pointers);
+    std::vector<pexExcept::Exception const*> exceptions;
+    for (auto const& e : owned) exceptions.push_back(e.get());
+
+    auto byReference = [](pexExcept::Exception const* e) { return route(*e); };
+    auto byCast = [](pexExcept::Exception const* e) { return routeCast(*e); };
+    std::cout << boost::format("%-30s %10s\n") % "method" % "ns";
+    std::cout << boost::format("%-30s %10.1f\n") % "dispatch" % time(exceptions, byReference, nIter);
+    std::cout << boost::format("%-30s %10.1f\n") % "dynamic_cast chain" % time(exceptions, byCast, nIter);
+    std::cout << boost::format("%-30s %10.1f\n") % "dispatch (exception_ptr)" %
+                         time(pointers, routePointer, nIter / 20);
+    std::cout << boost::format("%-30s %10.1f\n") % "catch clauses (exception_ptr)" %
+                         time(pointers, routeCatch, nIter / 20);
+    return 0;
+}
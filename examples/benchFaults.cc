@@ -0,0 +1,95 @@
+/*
+ * This file is part of pex_exceptions.
+ *
+ * Developed for the LSST Data Management System.
+ * This product includes software developed by the LSST Project
+ * (https://www.lsst.org).
+ * See the COPYRIGHT file at the top-level directory of this distribution
+ * for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Measure how a per-source processing loop slows down as its failure rate rises, using fault
+ * injection to make a check in the loop fail at a chosen, reproducible rate.
+ *
+ * The check only injects faults if LSST_EXCEPT_CHECK_FAULTS is defined, so build with
+ * "scons checkFaults=1".
+ */
+
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+#include "boost/format.hpp"
+
+#include "lsst/pex/exceptions/asserts.h"
+
+namespace pexExcept = lsst::pex::exceptions;
+
+// Stand-in for measuring one source; the check never fails on its own.
+__attribute__((noinline)) double measure(double flux) {
+    LSST_CHECK(flux >= 0.0, pexExcept::InvalidParameterError, "Negative flux");
+    return std::sqrt(flux) * 1.0857;
+}
+
+// Measure every source, counting failures the way a pipeline task would.
+double measureAll(std::vector<double> const& fluxes, int& nFailed) {
+    double sum = 0.0;
+    for (double flux : fluxes) {
+        try {
+            sum += measure(flux);
+        } catch (pexExcept::InvalidParameterError const&) {
+            ++nFailed;
+        }
+    }
+    return sum;
+}
+
+int main(int argc, char** argv) {
+#if !defined(LSST_EXCEPT_CHECK_FAULTS) || defined(LSST_EXCEPT_NO_FAULT_INJECTION)
+    std::cerr << "The checks cannot inject faults in this build; rebuild with \"scons checkFaults=1\"\n";
+    return 1;
+#endif
+    std::size_t const n = argc > 1 ? std::atol(argv[1]) : 100000;
+    int const nIter = argc > 2 ? std::atoi(argv[2]) : 20;
+    std::vector<double> fluxes(n);
+    for (std::size_t i = 0; i != n; ++i) {
+        fluxes[i] = 100.0 + i % 1000;
+    }
+    std::cout << boost::format("%12s %12s %16s\n") % "failure rate" % "failed" % "ns/source";
+    for (double rate : {0.0, 0.001, 0.01, 0.05, 0.2}) {
+        if (rate > 0.0) {
+            pexExcept::setFaultRules((boost::format("type=InvalidParameterError,probability=%g,seed=1") %
+                                      rate).str());
+        } else {
+            pexExcept::clearFaultRules();
+        }
+        int nFailed = 0;
+        double sum = 0.0;
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < nIter; ++i) {
+            sum += measureAll(fluxes, nFailed);
+        }
+        auto stop = std::chrono::steady_clock::now();
+        double ns = std::chrono::duration<double, std::nano>(stop - start).count() / nIter / n;
+        std::cout << boost::format("%12g %12d %16.2f  (checksum %g)\n") % rate % (nFailed / nIter) % ns %
+                             sum;
+    }
+    pexExcept::clearFaultRules();
+    return 0;
+}
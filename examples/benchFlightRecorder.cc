@@ -0,0 +1,73 @@
+/*
+ * This file is part of pex_exceptions.
+ *
+ * Developed for the LSST Data Management System.
+ * This product includes software developed by the LSST Project
+ * (https://www.lsst.org).
+ * See the COPYRIGHT file at the top-level directory of this distribution
+ * for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Measure the cost the flight recorder adds to constructing and throwing an exception.
+ */
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+
+#include "boost/format.hpp"
+
+#include "lsst/pex/exceptions/FlightRecorder.h"
+#include "lsst/pex/exceptions/Runtime.h"
+
+namespace pexExcept = lsst::pex::exceptions;
+
+template <typename F>
+double time(F func, int nIter) {
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < nIter; ++i) {
+        func();
+    }
+    auto stop = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(stop - start).count() / nIter;
+}
+
+int main(int argc, char** argv) {
+    int const nIter = argc > 1 ? std::atoi(argv[1]) : 1000000;
+    std::cout << boost::format("%10s %16s %12s\n") % "recorder" % "construct (ns)" % "throw (ns)";
+    for (bool enabled : {false, true}) {
+        pexExcept::setFlightRecorderEnabled(enabled);
+        double constructNs = time(
+                []() {
+                    pexExcept::NotFoundError error =
+                            LSST_EXCEPT(pexExcept::NotFoundError, "lookup failed for key");
+                    asm volatile("" : : "r"(&error) : "memory");
+                },
+                nIter);
+        double throwNs = time(
+                []() {
+                    try {
+                        throw LSST_EXCEPT(pexExcept::NotFoundError, "lookup failed for key");
+                    } catch (pexExcept::NotFoundError const&) {
+                    }
+                },
+                nIter / 10);
+        std::cout << boost::format("%10s %16.1f %12.1f\n") % (enabled ? "on" : "off") % constructNs %
+                             throwNs;
+    }
+    return 0;
+}
@@ -0,0 +1,113 @@
+/*
+ * This file is part of pex_exceptions.
+ *
+ * Developed for the LSST Data Management System.
+ * This product includes software developed by the LSST Project
+ * (https://www.lsst.org).
+ * See the COPYRIGHT file at the top-level directory of this distribution
+ * for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Measure the throughput of lookups that report a miss by throwing NotFoundError.
+ *
+ * Compares a full exception (LSST_EXCEPT), a lightweight one (LSST_EXCEPT_LIGHT), a lightweight one
+ * that is annotated with LSST_EXCEPT_ADD on its way up (and so upgraded), and, for reference, a
+ * lookup that reports the miss with a return value.  Each throw is caught one call up.
+ *
+ * Usage: benchLightweight [iterations]
+ */
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <string>
+
+#include "boost/format.hpp"
+
+#include "lsst/pex/exceptions/Runtime.h"
+
+namespace pexExcept = lsst::pex::exceptions;
+
+namespace {
+
+std::map<int, int> const table = {{1, 10}, {2, 20}, {3, 30}};
+
+template <typename F>
+double time(F func, int nIter) {
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < nIter; ++i) {
+        func(i);
+    }
+    auto stop = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(stop - start).count() / nIter;
+}
+
+__attribute__((noinline)) int lookupFull(int key) {
+    auto iter = table.find(key);
+    if (iter == table.end()) throw LSST_EXCEPT(pexExcept::NotFoundError, "Key not found in table");
+    return iter->second;
+}
+
+__attribute__((noinline)) int lookupLight(int key) {
+    auto iter = table.find(key);
+    if (iter == table.end()) throw LSST_EXCEPT_LIGHT(pexExcept::NotFoundError, "Key not found in table");
+    return iter->second;
+}
+
+__attribute__((noinline)) int lookupUpgraded(int key) {
+    try {
+        return lookupLight(key);
+    } catch (pexExcept::NotFoundError& e) {
+        LSST_EXCEPT_ADD(e, "while reading the table");
+        throw;
+    }
+}
+
+__attribute__((noinline)) int const* lookupPointer(int key) {
+    auto iter = table.find(key);
+    return iter == table.end() ? nullptr : &iter->second;
+}
+
+template <int (*lookup)(int)>
+void miss(int i) {
+    try {
+        lookup(100 + i);
+    } catch (pexExcept::NotFoundError const&) {
+    }
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    int const nIter = argc > 1 ? std::atoi(argv[1]) : 1000000;
+    double const pointerNs = time(
+            [](int i) {
+                int const* value = lookupPointer(100 + i);
+                asm volatile("" : : "r"(value) : "memory");
+            },
+            nIter);
+    std::cout << boost::format("%-24s %12s %16s\n") % "miss reported by" % "ns/miss" % "misses/s";
+    for (auto const& entry : {std::make_pair("return value", pointerNs),
+                              std::make_pair("LSST_EXCEPT", time(miss<lookupFull>, nIter)),
+                              std::make_pair("LSST_EXCEPT_LIGHT", time(miss<lookupLight>, nIter)),
+                              std::make_pair("LSST_EXCEPT_LIGHT + ADD", time(miss<lookupUpgraded>, nIter))}) {
+        std::cout << boost::format("%-24s %12.1f %16.3g\n") % entry.first % entry.second %
+                             (1e9 / entry.second);
+    }
+    return 0;
+}
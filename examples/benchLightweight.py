@@ -0,0 +1,74 @@
+#!/usr/bin/env python
+# This file is part of pex_exceptions.
+#
+# Developed for the LSST Data Management System.
+# This product includes software developed by the LSST Project
+# (https://www.lsst.org).
+# See the COPYRIGHT file at the top-level directory of this distribution
+# for details of code ownership.
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+"""Measure the cost of a lookup miss raised in C++ and caught in Python.
+
+Compares a NotFoundError created with LSST_EXCEPT, one created with
+LSST_EXCEPT_LIGHT, and one upgraded by LSST_EXCEPT_ADD, all translated by the
+pybind11 exception translator, with a plain Python `KeyError` for reference.
+Uses the test module, so build the tests first, then run e.g.::
+
+    python examples/benchLightweight.py
+"""
+
+import argparse
+import os
+import sys
+import timeit
+
+sys.path.insert(0, os.path.join(os.path.dirname(os.path.abspath(__file__)), os.pardir, "tests"))
+
+import lsst.pex.exceptions  # noqa: E402, F401
+import _testLib as testLib  # noqa: E402
+
+
+def miss(function, *args):
+    try:
+        function(*args)
+    except LookupError:
+        pass
+
+
+def missDict():
+    try:
+        {}[0]
+    except KeyError:
+        pass
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split("\n\n")[0])
+    parser.add_argument("-n", "--number", type=int, default=100000, help="misses per measurement")
+    args = parser.parse_args()
+    cases = [("KeyError", missDict),
+             ("LSST_EXCEPT", lambda: miss(testLib.failNotFoundError1, "no such key")),
+             ("LSST_EXCEPT_LIGHT", lambda: miss(testLib.failLight)),
+             ("LSST_EXCEPT_LIGHT + ADD", lambda: miss(testLib.failLightAdded, "while reading"))]
+    print("%-24s %12s %16s" % ("miss raised by", "ns/miss", "misses/s"))
+    for name, function in cases:
+        seconds = min(timeit.repeat(function, number=args.number, repeat=3)) / args.number
+        print("%-24s %12.1f %16.3g" % (name, seconds*1e9, 1/seconds))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,112 @@
+/*
+ * This file is part of pex_exceptions.
+ *
+ * Developed for the LSST Data Management System.
+ * This product includes software developed by the LSST Project
+ * (https://www.lsst.org).
+ * See the COPYRIGHT file at the top-level directory of this distribution
+ * for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Stress test for throwing, annotating and catching exceptions on many threads at once.
+ *
+ * Each thread repeatedly throws a NotFoundError two calls deep, adds a message to it in an
+ * intermediate frame, rethrows, and catches it at the top.  The program reports the aggregate
+ * throughput and the scaling efficiency relative to one thread for 1, 2, 4, ... threads.
+ *
+ * Usage: benchThreads [maxThreads [iterationsPerThread]]
+ *
+ * How well this scales is mostly determined by the unwinder, not by this package: with GCC >= 12
+ * and glibc >= 2.35, libgcc finds unwind tables through _dl_find_object without taking a global
+ * lock; older toolchains serialize every throw on a mutex in _Unwind_Find_FDE, and this package
+ * offers no workaround for them.  The program prints which C library it was built against.  Run it on
+ * the machine in question: results depend on its core count and toolchain.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include "boost/format.hpp"
+
+#include "lsst/pex/exceptions/Runtime.h"
+
+namespace pexExcept = lsst::pex::exceptions;
+
+__attribute__((noinline)) void lookup(int) {
+    throw LSST_EXCEPT(pexExcept::NotFoundError, "no calibration for detector");
+}
+
+__attribute__((noinline)) void process(int key) {
+    try {
+        lookup(key);
+    } catch (pexExcept::NotFoundError& e) {
+        LSST_EXCEPT_ADD(e, "while processing visit");
+        throw;
+    }
+}
+
+void worker(int nIter, long* caught) {
+    long count = 0;
+    for (int i = 0; i < nIter; ++i) {
+        try {
+            process(i);
+        } catch (pexExcept::Exception const& e) {
+            count += e.getTraceback().size();
+        }
+    }
+    *caught = count;
+}
+
+// Return aggregate throughput, in exceptions per second, for the given number of threads.
+double run(int nThreads, int nIter) {
+    std::vector<long> caught(nThreads * 8);  // spaced out to avoid false sharing
+    std::vector<std::thread> threads;
+    auto start = std::chrono::steady_clock::now();
+    for (int t = 0; t < nThreads; ++t) {
+        threads.emplace_back(worker, nIter, &caught[t * 8]);
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    auto stop = std::chrono::steady_clock::now();
+    return nThreads * static_cast<double>(nIter) / std::chrono::duration<double>(stop - start).count();
+}
+
+int main(int argc, char** argv) {
+    int const maxThreads =
+            argc > 1 ? std::atoi(argv[1]) : std::max(1u, std::thread::hardware_concurrency());
+    int const nIter = argc > 2 ? std::atoi(argv[2]) : 100000;
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 35))
+    std::cout << "glibc " << __GLIBC__ << "." << __GLIBC_MINOR__ << ": _dl_find_object available\n";
+#else
+    std::cout << "_dl_find_object not available; throws may contend on the unwinder lock\n";
+#endif
+    std::cout << "hardware threads: " << std::thread::hardware_concurrency() << "\n";
+    std::cout << boost::format("%8s %16s %12s\n") % "threads" % "exceptions/s" % "efficiency";
+    double single = 0.0;
+    for (int nThreads = 1; nThreads <= maxThreads; nThreads *= 2) {
+        double rate = run(nThreads, nIter);
+        if (nThreads == 1) single = rate;
+        std::cout << boost::format("%8d %16.0f %11.1f%%\n") % nThreads % rate %
+                             (100.0 * rate / (nThreads * single));
+    }
+    return 0;
+}
@@ -0,0 +1,91 @@
+#!/usr/bin/env python
+# This file is part of pex_exceptions.
+#
+# Developed for the LSST Data Management System.
+# This product includes software developed by the LSST Project
+# (https://www.lsst.org).
+# See the COPYRIGHT file at the top-level directory of this distribution
+# for details of code ownership.
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+"""Report the cost of including each public header of this package.
+
+For every header, a translation unit containing only ``#include <header>``
+is preprocessed to count its size, and compiled with ``-fsyntax-only``
+several times to time its parse.  Run it through ``scons headercost``, or
+directly as e.g.::
+
+    python examples/measureHeaders.py --cxx g++ -- -std=c++17 -Iinclude -I$BASE_DIR/include
+"""
+
+import argparse
+import os
+import subprocess
+import sys
+import tempfile
+import time
+
+HEADERS = [
+    "lsst/pex/exceptions/ExceptionFwd.h",
+    "lsst/pex/exceptions/Exception.h",
+    "lsst/pex/exceptions/Runtime.h",
+    "lsst/pex/exceptions/asserts.h",
+    "lsst/pex/exceptions/FaultInjection.h",
+    "lsst/pex/exceptions/FlightRecorder.h",
+    "lsst/pex/exceptions/Observer.h",
+    "lsst/pex/exceptions.h",
+]
+
+
+def measure(cxx, flags, header, repeat):
+    """Return the preprocessed size in bytes and lines, and the best
+    ``-fsyntax-only`` time in seconds, of a file including ``header``.
+    """
+    with tempfile.NamedTemporaryFile("w", suffix=".cc", delete=False) as source:
+        source.write("#include \"%s\"\n" % header)
+    try:
+        preprocessed = subprocess.run(cxx + flags + ["-E", "-P", source.name], check=True,
+                                      stdout=subprocess.PIPE).stdout
+        best = None
+        for _ in range(repeat):
+            start = time.perf_counter()
+            subprocess.run(cxx + flags + ["-fsyntax-only", source.name], check=True)
+            elapsed = time.perf_counter() - start
+            best = elapsed if best is None else min(best, elapsed)
+        return len(preprocessed), preprocessed.count(b"\n"), best
+    finally:
+        os.unlink(source.name)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split("\n")[0])
+    parser.add_argument("--cxx", default="c++", help="compiler command")
+    parser.add_argument("--repeat", type=int, default=5, help="compilations to time per header")
+    parser.add_argument("flags", nargs="*", help="compiler flags, after --")
+    args = parser.parse_args()
+    cxx = args.cxx.split()
+    print("%-40s %12s %10s %10s" % ("header", "bytes", "lines", "parse (ms)"))
+    for header in HEADERS:
+        try:
+            size, lines, seconds = measure(cxx, args.flags, header, args.repeat)
+        except subprocess.CalledProcessError:
+            print("%-40s %12s" % (header, "failed"))
+            continue
+        print("%-40s %12d %10d %10.1f" % (header, size, lines, seconds*1000))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
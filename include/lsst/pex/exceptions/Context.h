@@ -0,0 +1,120 @@
+/*
+ * This file is part of pex_exceptions.
+ *
+ * Developed for the LSST Data Management System.
+ * This product includes software developed by the LSST Project
+ * (https://www.lsst.org).
+ * See the COPYRIGHT file at the top-level directory of this distribution
+ * for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef LSST_PEX_EXCEPTIONS_CONTEXT_H
+#define LSST_PEX_EXCEPTIONS_CONTEXT_H
+
+#include <cstddef>
+#include <tuple>
+#include <utility>
+
+#include "lsst/pex/exceptions/Exception.h"
+#include "lsst/pex/exceptions/asserts.h"
+
+namespace lsst {
+namespace pex {
+namespace exceptions {
+namespace detail {
+
+/**
+ * For internal use by LSST_EXCEPT_CONTEXT; add a tracepoint with a formatted message to an exception
+ * propagating out of a context.
+ *
+ * Never throws: if the message cannot be formatted, the format string is used instead, and if the
+ * tracepoint cannot be added the exception is left as it is.
+ */
+LSST_EXPORT void addContext(Exception& exception, TracepointSite const* site, char const* format,
+                            CheckValue const* values, std::size_t nValues) noexcept;
+
+/**
+ * For internal use by LSST_EXCEPT_CONTEXT; calls a function, adding a tracepoint to any LSST exception
+ * that propagates out of it.
+ *
+ * The arguments are held by reference, which is safe because the context only lives until the end of
+ * the full-expression that creates and calls it, and only formatted if an exception passes through.
+ */
+template <typename... Args>
+class Context {
+public:
+    Context(TracepointSite const* site, char const* format, Args&&... args) noexcept
+            : _site(site), _format(format), _args(std::forward<Args>(args)...) {}
+
+    Context(Context const&) = delete;
+    Context& operator=(Context const&) = delete;
+
+    /// Call `body` with no arguments, returning what it returns.
+    template <typename Body>
+    decltype(auto) operator()(Body&& body) && {
+        try {
+            return std::forward<Body>(body)();
+        } catch (Exception& e) {
+            _add(e);
+            throw;
+        }
+    }
+
+private:
+    LSST_EXCEPT_COLD void _add(Exception& exception) const noexcept {
+        std::apply(
+                [this, &exception](auto const&... args) {
+                    CheckValue const values[] = {makeCheckValue(args)..., CheckValue()};
+                    addContext(exception, _site, _format, values, sizeof...(args));
+                },
+                _args);
+    }
+
+    TracepointSite const* _site;
+    char const* _format;
+    std::tuple<Args&&...> _args;
+};
+
+template <typename... Args>
+Context(TracepointSite const*, char const*, Args&&...) -> Context<Args...>;
+
+}  // namespace detail
+}  // namespace exceptions
+}  // namespace pex
+}  // namespace lsst
+
+/**
+ * Add context to any LSST exception that propagates out of a block of code.
+ *
+ * `LSST_EXCEPT_CONTEXT(format, values...)(body)` calls `body`, a function taking no arguments, and
+ * returns its result.  This has the effect of a `try` block whose handler uses @ref LSST_EXCEPT_ADD
+ * and rethrows, without formatting the message unless an exception passes through.  The message is a
+ * Boost.Format string, formatted with the remaining arguments as for LSST_THROW_IF_NE.  Only LSST
+ * exceptions are caught; any other exception propagates untouched.  For example:
+ *
+ *     for (auto const& visit : visits) {
+ *         LSST_EXCEPT_CONTEXT("while processing visit %d of %s", visit.getId(), name)([&] {
+ *             process(visit);
+ *         });
+ *     }
+ *
+ * See @ref secExcContext.
+ *
+ * @param[in] ... Boost.Format string, followed by the values it formats.
+ */
+#define LSST_EXCEPT_CONTEXT(...) ::lsst::pex::exceptions::detail::Context(LSST_EXCEPT_HERE, __VA_ARGS__)
+
+#endif
@@ -0,0 +1,280 @@
+/*
+ * This file is part of pex_exceptions.
+ *
+ * Developed for the LSST Data Management System.
+ * This product includes software developed by the LSST Project
+ * (https://www.lsst.org).
+ * See the COPYRIGHT file at the top-level directory of this distribution
+ * for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef LSST_PEX_EXCEPTIONS_DISPATCH_H
+#define LSST_PEX_EXCEPTIONS_DISPATCH_H
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <tuple>
+#include <type_traits>
+#include <typeinfo>
+#include <utility>
+
+#include "lsst/pex/exceptions/Exception.h"
+#include "lsst/pex/exceptions/Runtime.h"
+
+namespace lsst {
+namespace pex {
+namespace exceptions {
+namespace detail {
+
+/**
+ * For internal use by dispatch(); the handlers chosen for the dynamic types seen so far by one set of
+ * handler types.
+ *
+ * Entries are found by the address of the type's std::type_info, and are never changed or removed
+ * once added, so lookups need no lock.  A type may have more than one std::type_info (one per shared
+ * object); each gets its own entry.  Once the table is full, further types are resolved every time.
+ */
+class DispatchTable {
+public:
+    static constexpr int NOT_FOUND = -1;
+
+    /// Return the index of the handler for a type, or NOT_FOUND if it has not been added.
+    int find(std::type_info const& type) const noexcept {
+        std::size_t const start = _slot(type);
+        for (std::size_t i = 0; i != SIZE; ++i) {
+            Entry const* entry = _entries[(start + i) % SIZE].load(std::memory_order_acquire);
+            if (!entry) break;
+            if (entry->type == &type) return entry->index;
+        }
+        return NOT_FOUND;
+    }
+
+    /// Record the index of the handler for a type; has no effect if the table is full.
+    LSST_EXPORT void add(std::type_info const& type, int index) noexcept;
+
+private:
+    static constexpr std::size_t SIZE = 64;
+
+    struct Entry {
+        std::type_info const* type;
+        int index;
+    };
+
+    static std::size_t _slot(std::type_info const& type) noexcept {
+        return (reinterpret_cast<std::uintptr_t>(&type) >> 4) % SIZE;
+    }
+
+    std::atomic<Entry const*> _entries[SIZE];  // zero-initialized as a static; see dispatchTable
+};
+
+/// The table for a set of handler parameter types, shared by all calls to dispatch() with those types.
+template <typename... Types>
+DispatchTable dispatchTable;
+
+/// The parameter and result types of a handler: a function, function pointer, or non-generic lambda.
+template <typename F>
+struct HandlerTraits : HandlerTraits<decltype(&F::operator())> {};
+
+template <typename R, typename P>
+struct HandlerTraits<R(P)> {
+    typedef R Result;
+    typedef P Param;
+    typedef std::remove_cv_t<std::remove_reference_t<P>> Type;
+};
+
+template <typename R, typename P>
+struct HandlerTraits<R (*)(P)> : HandlerTraits<R(P)> {};
+
+template <typename C, typename R, typename P>
+struct HandlerTraits<R (C::*)(P)> : HandlerTraits<R(P)> {};
+
+template <typename C, typename R, typename P>
+struct HandlerTraits<R (C::*)(P) const> : HandlerTraits<R(P)> {};
+
+template <typename R, typename P>
+struct HandlerTraits<R (*)(P) noexcept> : HandlerTraits<R(P)> {};
+
+template <typename C, typename R, typename P>
+struct HandlerTraits<R (C::*)(P) noexcept> : HandlerTraits<R(P)> {};
+
+template <typename C, typename R, typename P>
+struct HandlerTraits<R (C::*)(P) const noexcept> : HandlerTraits<R(P)> {};
+
+template <typename Handler>
+using HandlerType = typename HandlerTraits<std::decay_t<Handler>>::Type;
+
+/// Whether a pointer to Base can be converted to a pointer to T with static_cast (not a virtual base).
+template <typename T, typename Base, typename = void>
+struct IsStaticDowncast : std::false_type {};
+
+template <typename T, typename Base>
+struct IsStaticDowncast<T, Base, std::void_t<decltype(static_cast<T*>(std::declval<Base*>()))>>
+        : std::true_type {};
+
+/// Return an exception, known to be a T, as a T; const if the exception is.
+template <typename T, typename Base>
+decltype(auto) castException(Base& exception) noexcept {
+    typedef std::conditional_t<std::is_const<Base>::value, T const, T> Target;
+    if constexpr (std::is_base_of<T, std::remove_const_t<Base>>::value) {
+        return static_cast<Target&>(exception);
+    } else if constexpr (IsStaticDowncast<Target, Base>::value) {
+        return static_cast<Target&>(exception);
+    } else {
+        return dynamic_cast<Target&>(exception);
+    }
+}
+
+/// Return whether an exception is a T.
+template <typename T, typename Base>
+bool isException(Base& exception) noexcept {
+    if constexpr (std::is_base_of<T, std::remove_const_t<Base>>::value) {
+        return true;
+    } else {
+        return dynamic_cast<T const*>(&exception) != nullptr;
+    }
+}
+
+/// Return which of Types each of Types derives from (or is), as a row per type.
+template <typename T, typename... Types>
+constexpr std::array<bool, sizeof...(Types)> derivesFrom() {
+    return {{std::is_base_of<Types, T>::value...}};
+}
+
+/**
+ * Return the index of the most-derived of Types that an exception is, or DispatchTable::NOT_FOUND.
+ *
+ * Where neither of two matching types derives from the other (possible only with multiple
+ * inheritance), the first is preferred.
+ */
+template <typename... Types, typename Base>
+int resolveHandler(Base& exception) {
+    constexpr std::size_t n = sizeof...(Types);
+    constexpr std::array<std::array<bool, n>, n> derives = {{derivesFrom<Types, Types...>()...}};
+    bool const matches[n] = {isException<Types>(exception)...};
+    int best = DispatchTable::NOT_FOUND;
+    for (std::size_t i = 0; i != n; ++i) {
+        if (!matches[i]) continue;
+        if (best == DispatchTable::NOT_FOUND || (derives[i][best] && !derives[best][i])) {
+            best = static_cast<int>(i);
+        }
+    }
+    return best;
+}
+
+/// Return the index of the handler for an exception, from the table if it has been seen before.
+template <typename... Types, typename Base>
+int findHandler(Base& exception) {
+    DispatchTable& table = dispatchTable<Types...>;
+    std::type_info const& type = typeid(exception);
+    int index = table.find(type);
+    if (index == DispatchTable::NOT_FOUND) {
+        index = resolveHandler<Types...>(exception);
+        table.add(type, index);
+    }
+    return index;
+}
+
+/// Call the handler with the given index.
+template <typename Result, typename Base, typename Handlers, std::size_t... indices>
+Result callHandler(int index, Base& exception, Handlers& handlers, std::index_sequence<indices...>) {
+    typedef Result (*Call)(Base&, Handlers&);
+    static constexpr Call calls[] = {[](Base& exception, Handlers& handlers) -> Result {
+        auto& handler = std::get<indices>(handlers);
+        typedef HandlerType<decltype(handler)> Type;
+        return handler(castException<Type>(exception));
+    }...};
+    return calls[index](exception, handlers);
+}
+
+}  // namespace detail
+
+/**
+ * Call whichever of several handlers is for the most-derived type of an exception.
+ *
+ * This does the job of a sequence of catch clauses, or of a chain of `dynamic_cast`s, in the order
+ * that puts derived types first, for an exception that has already been caught.  For example:
+ *
+ *     Action action = dispatch(
+ *             e, [](NotFoundError const&) { return Action::SKIP; },
+ *             [](IoError const& e) { return e.getErrorCode() ? Action::RETRY : Action::FAIL; },
+ *             [](Exception const&) { return Action::FAIL; });
+ *
+ * The handler to call is worked out once for each dynamic type, and kept in a table shared by calls
+ * with the same handler types, so later calls cost a `typeid` and a table lookup whatever the
+ * number of handlers or the depth of the hierarchy.  Any exception type works, including those not
+ * defined by this package.
+ *
+ * @param[in] exception  The exception, whose dynamic type chooses the handler.
+ * @param[in] handlers   Functions or non-generic lambdas, each taking one exception type by
+ *                       reference (by const reference if `exception` is const).  One of them must take
+ *                       the static type of `exception` or a base of it, so that there is always a
+ *                       handler to call; where several match, the one for the most-derived type wins.
+ *
+ * @returns What the chosen handler returns.  All the handlers must have a common return type.
+ */
+template <typename Base, typename... Handlers,
+          typename = std::enable_if_t<!std::is_same<std::remove_const_t<Base>, std::exception_ptr>::value>>
+auto dispatch(Base& exception, Handlers&&... handlers) {
+    typedef std::common_type_t<typename detail::HandlerTraits<std::decay_t<Handlers>>::Result...> Result;
+    static_assert(std::is_polymorphic<Base>::value, "dispatch() needs an exception of polymorphic type");
+    static_assert((std::is_base_of<detail::HandlerType<Handlers>, std::remove_const_t<Base>>::value || ...),
+                  "dispatch() needs a handler that accepts every exception of the static type");
+    int const index = detail::findHandler<detail::HandlerType<Handlers>...>(exception);
+    std::tuple<Handlers&...> all(handlers...);
+    return detail::callHandler<Result>(index, exception, all, std::index_sequence_for<Handlers...>());
+}
+
+/**
+ * Call whichever of several handlers is for the most-derived type of a stored exception.
+ *
+ * This is equivalent to rethrowing the exception inside a `try` block with a catch clause for each
+ * handler, ordered so that derived types come first, except that the handler is chosen as by
+ * dispatch(std::exception&, ...).  The exception is rethrown once, to reach it; an exception that no
+ * handler accepts (or that is not a std::exception) propagates.
+ *
+ * @param[in] exception  The exception, which must not be null.
+ * @param[in] handlers   Functions or non-generic lambdas, each taking a type derived from (or the same
+ *                       as) std::exception by reference.
+ *
+ * @returns What the chosen handler returns.  All the handlers must have a common return type.
+ *
+ * @throws InvalidParameterError Thrown if `exception` is null.
+ */
+template <typename... Handlers>
+auto dispatch(std::exception_ptr const& exception, Handlers&&... handlers) {
+    typedef std::common_type_t<typename detail::HandlerTraits<std::decay_t<Handlers>>::Result...> Result;
+    static_assert(sizeof...(Handlers) > 0, "dispatch() needs at least one handler");
+    if (!exception) {
+        throw LSST_EXCEPT(InvalidParameterError, "Cannot dispatch a null exception_ptr");
+    }
+    try {
+        std::rethrow_exception(exception);
+    } catch (std::exception& caught) {
+        int const index = detail::findHandler<detail::HandlerType<Handlers>...>(caught);
+        if (index == detail::DispatchTable::NOT_FOUND) throw;
+        std::tuple<Handlers&...> all(handlers...);
+        return detail::callHandler<Result>(index, caught, all, std::index_sequence_for<Handlers...>());
+    }
+}
+
+}  // namespace exceptions
+}  // namespace pex
+}  // namespace lsst
+
+#endif
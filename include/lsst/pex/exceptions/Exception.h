@@ -24,20 +24,97 @@
 #ifndef LSST_PEX_EXCEPTIONS_EXCEPTION_H
 #define LSST_PEX_EXCEPTIONS_EXCEPTION_H
 
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
 #include <exception>
-#include <ostream>
+#include <iosfwd>
 #include <string>
+#include <system_error>
+#include <type_traits>
+#include <typeinfo>
+#include <utility>
 #include <vector>
 
 #include "lsst/base.h"
-#include "boost/current_function.hpp"
+#include "lsst/pex/exceptions/ExceptionFwd.h"
 
 namespace lsst {
 namespace pex {
 namespace exceptions {
 
-/// For internal use; gathers the file, line, and function for a tracepoint.
-#define LSST_EXCEPT_HERE __FILE__, __LINE__, BOOST_CURRENT_FUNCTION
+/**
+ * For internal use; the function name recorded in tracepoints.
+ *
+ * By default this is the full signature (as from BOOST_CURRENT_FUNCTION), which for template code can
+ * be very long and is stored once per instantiation.  Defining LSST_EXCEPT_SHORT_FUNCTION_NAMES when
+ * compiling records just the unqualified function name instead (from `__builtin_FUNCTION()` where
+ * available, as unlike `__func__` it is also valid in default member initializers and arguments).
+ */
+#if defined(LSST_EXCEPT_SHORT_FUNCTION_NAMES) && defined(__GNUC__)
+#define LSST_EXCEPT_FUNCTION __builtin_FUNCTION()
+#elif defined(LSST_EXCEPT_SHORT_FUNCTION_NAMES)
+#define LSST_EXCEPT_FUNCTION __func__
+#elif defined(__GNUC__)
+#define LSST_EXCEPT_FUNCTION __PRETTY_FUNCTION__
+#elif defined(_MSC_VER)
+#define LSST_EXCEPT_FUNCTION __FUNCSIG__
+#else
+#define LSST_EXCEPT_FUNCTION __func__
+#endif
+
+/**
+ * For internal use; a pointer to a static TracepointSite for the current file, line, and function.
+ *
+ * Each use creates one constant-initialized record, so throwing or adding a message only passes a
+ * single pointer.
+ */
+#define LSST_EXCEPT_HERE LSST_EXCEPT_SITE_(nullptr)
+
+/// For internal use; like @ref LSST_EXCEPT_HERE, but also records the type of exception created there.
+#define LSST_EXCEPT_TYPED_HERE(type) LSST_EXCEPT_SITE_(&typeid(type))
+
+/*
+ * The record is a static variable of an immediately invoked lambda, rather than of the enclosing
+ * function, so that the macros are expressions that may also appear in constexpr functions (which
+ * may not define static variables before C++23), default member initializers and default arguments.
+ * The record is constant-initialized.  The enclosing function's name cannot be a constant inside the
+ * lambda, so it is taken in the enclosing scope, passed to the lambda, and stored the first time the
+ * site is reached in a slot that the record points to.
+ */
+#if defined(LSST_EXCEPT_SITE_IDS) && defined(__GNUC__)
+/*
+ * In site ID mode the site record holds only an ID computed from the file and line, so neither string
+ * is compiled into the object.  The location is instead written, with the address of the site, to the
+ * non-allocated section .lsst_except_sites (in the same COMDAT group as the function, so that it is
+ * dropped with discarded inline functions), from which siteMap.py builds the map used by loadSiteMap().
+ */
+#define LSST_EXCEPT_STRINGIFY_(x) LSST_EXCEPT_STRINGIFY2_(x)
+#define LSST_EXCEPT_STRINGIFY2_(x) #x
+#define LSST_EXCEPT_SITE_(typeinfo)                                                                          \
+    []() {                                                                                                   \
+        __asm__ volatile("1:\n\t.pushsection .lsst_except_sites,\"?\",%progbits\n\t.balign 8\n"              \
+                         "\t.dc.a 1b\n\t.long " LSST_EXCEPT_STRINGIFY_(__LINE__) "\n"                        \
+                         "\t.asciz \"" __FILE__ "\"\n\t.popsection");                                        \
+        static constexpr ::lsst::pex::exceptions::TracepointSite lsstExceptSite =                            \
+                ::lsst::pex::exceptions::TracepointSite::fromId(                                             \
+                        ::lsst::pex::exceptions::TracepointSite::hashLocation(__FILE__, __LINE__),           \
+                        __LINE__, typeinfo);                                                                 \
+        return &lsstExceptSite;                                                                              \
+    }()
+#else
+#define LSST_EXCEPT_SITE_(typeinfo)                                                                          \
+    [](char const* lsstExceptFunction) {                                                                     \
+        static ::std::atomic<char const*> lsstExceptFunctionSlot(nullptr);                                   \
+        static constexpr ::lsst::pex::exceptions::TracepointSite lsstExceptSite =                            \
+                ::lsst::pex::exceptions::TracepointSite::withFunctionSlot(                                   \
+                        __FILE__, __LINE__, &lsstExceptFunctionSlot, typeinfo);                              \
+        if (lsstExceptFunctionSlot.load(::std::memory_order_relaxed) == nullptr) {                           \
+            lsstExceptFunctionSlot.store(lsstExceptFunction, ::std::memory_order_relaxed);                   \
+        }                                                                                                    \
+        return &lsstExceptSite;                                                                              \
+    }(LSST_EXCEPT_FUNCTION)
+#endif
 
 /**
  * Create an exception with a given type.
@@ -45,7 +122,63 @@ namespace exceptions {
  * @param[in] type C++ type of the exception to be thrown.
  * @param[in] ... The message, and optionally other arguments (dependent on the type).
  */
-#define LSST_EXCEPT(type, ...) type(LSST_EXCEPT_HERE, __VA_ARGS__)
+#define LSST_EXCEPT(type, ...)                                                                               \
+    ::lsst::pex::exceptions::detail::construct<type>(LSST_EXCEPT_TYPED_HERE(type), __VA_ARGS__)
+
+/**
+ * Create an exception that records the current value of `errno` and the path it applies to.
+ *
+ * The message, error description and path are only combined into a single string if the text of
+ * the exception is requested; see Exception::getErrorCode and Exception::getPath.  `errno` is read
+ * when the macro's arguments are evaluated, so compute a message or path that might change it
+ * beforehand.
+ *
+ * For example:
+ *
+ *     if (!stream) throw LSST_EXCEPT_ERRNO(IoError, "Failed to open file", filename);
+ *
+ * @param[in] type C++ type of the exception to be thrown.
+ * @param[in] message Description of the operation that failed (may be empty).
+ * @param[in] path Path of the file the error applies to (may be empty).
+ */
+#define LSST_EXCEPT_ERRNO(type, message, path)                                                               \
+    ::lsst::pex::exceptions::detail::construct<type>(LSST_EXCEPT_TYPED_HERE(type), message,                  \
+                                                     std::error_code(errno, std::generic_category()), path)
+
+/**
+ * Create an exception with a given type that was caused by another exception.
+ *
+ * The cause is shared, not copied or converted to text; it is shown by the stream operator and
+ * becomes `__cause__` when the exception is translated to Python.  The cause can be any exception,
+ * and is usually the one being handled:
+ *
+ *     } catch (NotFoundError const&) {
+ *         throw LSST_EXCEPT_FROM(RuntimeError, std::current_exception(), "Could not load calibration");
+ *     }
+ *
+ * @param[in] type C++ type of the exception to be thrown.
+ * @param[in] cause `std::exception_ptr` to the exception that caused this one.
+ * @param[in] ... The message, and optionally other arguments (dependent on the type).
+ */
+#define LSST_EXCEPT_FROM(type, cause, ...)                                                                   \
+    ::lsst::pex::exceptions::detail::withCause(                                                              \
+            ::lsst::pex::exceptions::detail::construct<type>(LSST_EXCEPT_TYPED_HERE(type), __VA_ARGS__),     \
+            cause)
+
+/**
+ * Create a lightweight exception with a given type, for errors that are part of normal control flow.
+ *
+ * The exception is caught as the given type, in C++ and Python, but records only the throw site and
+ * the (static) message, without allocating a traceback.  It becomes a full exception if
+ * @ref LSST_EXCEPT_ADD is used on it.  See @ref secExcLightweight.
+ *
+ *     if (iter == _map.end()) throw LSST_EXCEPT_LIGHT(NotFoundError, "Key not found");
+ *
+ * @param[in] type C++ type of the exception to be thrown.
+ * @param[in] message String literal message.
+ */
+#define LSST_EXCEPT_LIGHT(type, message) \
+    type(LSST_EXCEPT_TYPED_HERE(type), ::lsst::pex::exceptions::StaticMessage(message))
 
 /**
  * @brief Add the current location and a message to an existing exception before
@@ -59,27 +192,209 @@ namespace exceptions {
 /// The initial arguments to the base class constructor for new subclasses.
 #define LSST_EARGS_UNTYPED ex_file, ex_line, ex_func, ex_message
 
+/**
+ * The initial arguments for new exception subclasses that take their location as a TracepointSite.
+ *
+ * @ref LSST_EXCEPT creates subclasses declared with either these or @ref LSST_EARGS_TYPED, but only
+ * these avoid interning the location on each construction.
+ */
+#define LSST_EARGS_SITE_TYPED \
+    lsst::pex::exceptions::TracepointSite const *ex_site, std::string const &ex_message
+
+/// The initial arguments to the base class constructor for subclasses using @ref LSST_EARGS_SITE_TYPED.
+#define LSST_EARGS_SITE_UNTYPED ex_site, ex_message
+
 /**
  * Macro used to define new types of exceptions without additional data.
  *
+ * The new type inherits all constructors of its base class.
+ *
  * @param[in] t Type of the exception.
  * @param[in] b Base class of the exception.
  * @param[in] c C++ class of the exception (fully specified).
  */
 #define LSST_EXCEPTION_TYPE(t, b, c)                                                          \
     class LSST_EXPORT t : public b {                                                                      \
+        typedef b LsstExceptionBase;                                                          \
+                                                                                              \
     public:                                                                                   \
-        t(LSST_EARGS_TYPED) : b(LSST_EARGS_UNTYPED){};                                        \
+        using LsstExceptionBase::LsstExceptionBase;                                           \
         t(std::string const& message) : b(message){};                                         \
         virtual char const* getType(void) const noexcept { return #c " *"; };                 \
         virtual lsst::pex::exceptions::Exception* clone(void) const { return new t(*this); }; \
     };
 
+/**
+ * Declare a new type of exception whose vtable and RTTI are emitted in a single source file.
+ *
+ * The declared class is the same as with @ref LSST_EXCEPTION_TYPE, but its destructor, getType()
+ * and clone() are only declared, so the destructor acts as the key function.  The vtable, type_info
+ * and virtual function bodies are then emitted once, by @ref LSST_EXCEPTION_TYPE_DEFINE in the
+ * library that owns the type, instead of as weak copies in every translation unit that includes
+ * the header.  This also gives the type a single type_info across shared objects, so catching it in
+ * another library does not rely on comparing type names.
+ *
+ * @param[in] t Type of the exception.
+ * @param[in] b Base class of the exception.
+ * @param[in] c C++ class of the exception (fully specified).
+ */
+#define LSST_EXCEPTION_TYPE_DECL(t, b, c)                                                                    \
+    class LSST_EXPORT t : public b {                                                                         \
+        typedef b LsstExceptionBase;                                                                         \
+                                                                                                             \
+    public:                                                                                                  \
+        using LsstExceptionBase::LsstExceptionBase;                                                          \
+        t(std::string const& message) : b(message){};                                                        \
+        virtual ~t(void) noexcept;                                                                           \
+        virtual char const* getType(void) const noexcept;                                                    \
+        virtual lsst::pex::exceptions::Exception* clone(void) const;                                         \
+    };
+
+/**
+ * Define the out-of-line members of an exception declared with @ref LSST_EXCEPTION_TYPE_DECL.
+ *
+ * Use exactly once, in a source file of the library that owns the type, in the namespace that
+ * contains the type.
+ *
+ * @param[in] t Type of the exception.
+ * @param[in] c C++ class of the exception (fully specified).
+ */
+#define LSST_EXCEPTION_TYPE_DEFINE(t, c)                                                                     \
+    t::~t(void) noexcept {}                                                                                  \
+    char const* t::getType(void) const noexcept { return #c " *"; }                                          \
+    lsst::pex::exceptions::Exception* t::clone(void) const { return new t(*this); }
+
+/**
+ * The source location of an LSST_EXCEPT or LSST_EXCEPT_ADD call.
+ *
+ * Instances are normally static constants created by @ref LSST_EXCEPT_HERE, one per call site, and
+ * are referred to (never owned) by Tracepoint.
+ */
+struct LSST_EXPORT TracepointSite {
+    /**
+     * Construct a site record; usable in constant expressions.
+     *
+     * @param[in] file Filename.
+     * @param[in] line Line number.
+     * @param[in] func Function name.
+     * @param[in] type Type of the exception created at this site, if known.
+     */
+    constexpr TracepointSite(char const* file, int line, char const* func,
+                             std::type_info const* type = nullptr) noexcept
+            : _file(file),
+              _line(line),
+              _func(func),
+              _funcSlot(nullptr),
+              _type(type),
+              _hash(hashLocation(file, line)) {}
+
+    /**
+     * Return a site record with the given location that lives until the end of the program.
+     *
+     * This is used when the location is not known at compile time (e.g. it comes from Python or a
+     * subclass constructor that takes a file, line and function).  The strings are copied, and each
+     * distinct location is stored once.
+     *
+     * @param[in] file Filename.
+     * @param[in] line Line number.
+     * @param[in] func Function name.
+     * @param[in] type Type of the exception created at this site, if known.
+     */
+    static TracepointSite const* intern(char const* file, int line, char const* func,
+                                        std::type_info const* type = nullptr);
+
+    /**
+     * Construct a site record that has an ID but no file or function name (see @ref secExcSiteIds);
+     * usable in constant expressions.
+     *
+     * @param[in] id ID of the site; the hashLocation() of its file and line.
+     * @param[in] line Line number.
+     * @param[in] type Type of the exception created at this site, if known.
+     */
+    static constexpr TracepointSite fromId(std::uint64_t id, int line,
+                                           std::type_info const* type = nullptr) noexcept {
+        TracepointSite site(nullptr, line, nullptr, type);
+        site._hash = id;
+        return site;
+    }
+
+    /**
+     * Construct a site record whose function name is stored in a slot the first time the site is
+     * reached (see @ref LSST_EXCEPT_HERE); usable in constant expressions.
+     *
+     * @param[in] file Filename.
+     * @param[in] line Line number.
+     * @param[in] funcSlot Slot that holds the function name, or null until it is known.
+     * @param[in] type Type of the exception created at this site, if known.
+     */
+    static constexpr TracepointSite withFunctionSlot(char const* file, int line,
+                                                     std::atomic<char const*> const* funcSlot,
+                                                     std::type_info const* type = nullptr) noexcept {
+        TracepointSite site(file, line, nullptr, type);
+        site._funcSlot = funcSlot;
+        return site;
+    }
+
+    /// Compute a 64-bit FNV-1a hash of a file name and line number.
+    static constexpr std::uint64_t hashLocation(char const* file, int line) noexcept {
+        std::uint64_t hash = 14695981039346656037ULL;
+        for (char const* c = file; c && *c; ++c) {
+            hash = (hash ^ static_cast<unsigned char>(*c)) * 1099511628211ULL;
+        }
+        return (hash ^ static_cast<std::uint32_t>(line)) * 1099511628211ULL;
+    }
+
+    /// Filename of the site, looked up in the loaded site maps if the site only has an ID.
+    char const* getFile(void) const noexcept { return _file ? _file : _lookupFile(); }
+
+    /// Function name of the site, looked up in the loaded site maps if the site only has an ID.
+    char const* getFunction(void) const noexcept {
+        char const* func = getCompiledFunction();
+        return func ? func : _lookupFunction();
+    }
+
+    /// Function name of the site, or null if the site only has an ID; async-signal-safe.
+    char const* getCompiledFunction(void) const noexcept {
+        return _funcSlot ? _funcSlot->load(std::memory_order_relaxed) : _func;
+    }
+
+    char const* _file;  // Compiled strings only, or null if the site only has an ID; does not need deletion
+    int _line;
+    char const* _func;  // Compiled strings only, or null if held in _funcSlot or the site only has an ID
+    std::atomic<char const*> const* _funcSlot;  // Set by LSST_EXCEPT_HERE; see getCompiledFunction()
+    std::type_info const* _type;  // Null for LSST_EXCEPT_ADD and other untyped sites
+    std::uint64_t _hash;          // Also the ID of the site
+
+private:
+    char const* _lookupFile(void) const noexcept;
+    char const* _lookupFunction(void) const noexcept;
+};
+
+/**
+ * A message with static storage duration, for lightweight exceptions (see @ref LSST_EXCEPT_LIGHT).
+ *
+ * Only string literals (and other character arrays) are accepted, as the message is not copied.
+ */
+struct StaticMessage {
+    template <std::size_t N>
+    explicit constexpr StaticMessage(char const (&text)[N]) noexcept : _text(text) {}
+
+    char const* _text;
+};
+
 /// One point in the Traceback vector held by Exception
-struct Tracepoint {
+struct LSST_EXPORT Tracepoint {
     /**
      * Standard constructor, intended for C++ use.
      *
+     * @param[in] site Source location (see @ref LSST_EXCEPT_HERE).
+     * @param[in] message Informational string attached to exception.
+     */
+    Tracepoint(TracepointSite const* site, std::string const& message);
+
+    /**
+     * Construct from a file, line, and function, which are copied into an interned TracepointSite.
+     *
      * @param[in] file Filename.
      * @param[in] line Line number.
      * @param[in] func Function name.
@@ -87,9 +402,25 @@ struct Tracepoint {
      */
     Tracepoint(char const* file, int line, char const* func, std::string const& message);
 
-    char const* _file;  // Compiled strings only; does not need deletion
-    int _line;
-    char const* _func;  // Compiled strings only; does not need deletion
+    /// Filename of the tracepoint.
+    char const* getFile(void) const noexcept { return _site->getFile(); }
+
+    /// Line number of the tracepoint.
+    int getLine(void) const noexcept { return _site->_line; }
+
+    /// Function name of the tracepoint.
+    char const* getFunction(void) const noexcept { return _site->getFunction(); }
+
+    /// Filename of the tracepoint; the same as getFile(), for code written when this was a field.
+    char const* _file(void) const noexcept { return getFile(); }
+
+    /// Line number of the tracepoint; the same as getLine(), for code written when this was a field.
+    int _line(void) const noexcept { return getLine(); }
+
+    /// Function name of the tracepoint; the same as getFunction(), for code written when this was a field.
+    char const* _func(void) const noexcept { return getFunction(); }
+
+    TracepointSite const* _site;  // Static or interned; does not need deletion
     std::string _message;
 };
 typedef std::vector<Tracepoint> Traceback;
@@ -109,13 +440,33 @@ public:
     /**
      * Standard constructor, intended for C++ use via the LSST_EXCEPT() macro.
      *
-     * @param[in] file Filename (automatically passed in by macro).
-     * @param[in] line Line number (automatically passed in by macro).
-     * @param[in] func Function name (automatically passed in by macro).
+     * @param[in] site Source location (automatically passed in by macro).
+     * @param[in] message Informational string attached to exception.
+     */
+    Exception(TracepointSite const* site,
+              std::string const& message);  // Should use LSST_EARGS_SITE_TYPED, but that confuses doxygen.
+
+    /**
+     * Construct from a file, line, and function, for subclasses that forward those explicitly.
+     *
+     * @param[in] file Filename.
+     * @param[in] line Line number.
+     * @param[in] func Function name.
      * @param[in] message Informational string attached to exception.
      */
-    Exception(char const* file, int line, char const* func,
-              std::string const& message);  // Should use LSST_EARGS_TYPED, but that confuses doxygen.
+    Exception(char const* file, int line, char const* func, std::string const& message);
+
+    /**
+     * Construct a lightweight exception, intended for C++ use via the @ref LSST_EXCEPT_LIGHT macro.
+     *
+     * The exception has no traceback, error code, path or cause, and is not recorded by the flight
+     * recorder or reported to observers, until it is upgraded to a full exception by addMessage() or
+     * setCause().
+     *
+     * @param[in] site Source location (automatically passed in by macro).
+     * @param[in] message Informational string attached to exception; not copied.
+     */
+    Exception(TracepointSite const* site, StaticMessage message) noexcept;
 
     /**
      * Message-only constructor, intended for use from Python only.
@@ -129,30 +480,130 @@ public:
      */
     explicit Exception(std::string const& message);
 
+    /**
+     * Construct with a structured error code and path, intended for C++ use via LSST_EXCEPT or
+     * @ref LSST_EXCEPT_ERRNO.
+     *
+     * The text of the exception (see what()) is the message, followed by the description of the
+     * error code and the path, but it is only formatted when first requested.
+     *
+     * @param[in] site Source location (automatically passed in by macro).
+     * @param[in] message Informational string attached to exception (may be empty).
+     * @param[in] errorCode Error code of the failure; a default-constructed code means none.
+     * @param[in] path Path of the file the error applies to (may be empty).
+     */
+    Exception(TracepointSite const* site, std::string const& message, std::error_code const& errorCode,
+              std::string const& path);
+
+    /**
+     * Message-only form of the error code constructor, intended for use from Python only.
+     *
+     * @param[in] message Informational string attached to exception (may be empty).
+     * @param[in] errorCode Error code of the failure; a default-constructed code means none.
+     * @param[in] path Path of the file the error applies to (may be empty).
+     */
+    Exception(std::string const& message, std::error_code const& errorCode, std::string const& path);
+
+    /**
+     * Copy an exception.
+     *
+     * The message and traceback are shared with the original until either one is modified by
+     * addMessage(), so copying costs a reference-count increment regardless of traceback depth.
+     * There is no separate move constructor, so a moved-from exception remains usable.
+     */
+    Exception(Exception const& other) noexcept;
+
+    /// Assign from another exception, sharing its message and traceback (see the copy constructor).
+    Exception& operator=(Exception const& other) noexcept;
+
     virtual ~Exception(void) noexcept;
 
     /**
      * Add a tracepoint and a message to an exception before rethrowing it (access via @ref LSST_EXCEPT_ADD).
      *
-     * @param[in] file Filename (automatically passed in by macro).
-     * @param[in] line Line number (automatically passed in by macro).
-     * @param[in] func Function name (automatically passed in by macro).
+     * @param[in] site Source location (automatically passed in by macro).
+     * @param[in] message Additional message to associate with this rethrow.
+     */
+    void addMessage(TracepointSite const* site, std::string const& message);
+
+    /**
+     * Add a tracepoint and a message given a file, line, and function.
+     *
+     * @param[in] file Filename.
+     * @param[in] line Line number.
+     * @param[in] func Function name.
      * @param[in] message Additional message to associate with this rethrow.
      */
     void addMessage(char const* file, int line, char const* func, std::string const& message);
 
-    /// Retrieve the list of tracepoints associated with an exception.
+    /**
+     * Retrieve the list of tracepoints associated with an exception.
+     *
+     * This is empty for exceptions created from Python and for lightweight exceptions.
+     */
     Traceback const& getTraceback(void) const noexcept;
 
+    /// Return whether this is a lightweight exception (see @ref LSST_EXCEPT_LIGHT) not yet upgraded.
+    bool isLightweight(void) const noexcept { return !_payload; }
+
+    /// Return the error code the exception was created with; false if there was none.
+    std::error_code getErrorCode(void) const noexcept;
+
+    /// Return the path the exception was created with; empty if there was none.
+    std::string const& getPath(void) const noexcept;
+
+    /**
+     * Record the exception that caused this one (usually via @ref LSST_EXCEPT_FROM).
+     *
+     * @param[in] cause Pointer to the causing exception, shared with the caller; null to clear.
+     */
+    void setCause(std::exception_ptr cause);
+
+    /// Return the exception that caused this one, or a null pointer if there is none.
+    std::exception_ptr getCause(void) const noexcept;
+
+    /**
+     * Return the approximate number of bytes of memory used by this exception.
+     *
+     * This covers the object itself and its message, tracepoints and tracepoint messages, including
+     * unused container capacity.  Copies share these until one is modified, so each reports them in
+     * full.  The cause is not included; it is a separate exception (see getCause()).
+     */
+    std::size_t memoryFootprint(void) const noexcept;
+
     /**
      * @brief Add a text representation of this exception, including its traceback with
      * messages, to a stream.
      *
+     * If the exception has a cause, it is added after the exception itself, following a
+     * "Caused by:" line.  At most 16 causes are added, so that a circular chain of causes ends.
+     *
      * @param[in] stream Reference to an output stream.
      * @returns Reference to the output stream after adding the text.
      */
     virtual std::ostream& addToStream(std::ostream& stream) const;
 
+    /**
+     * Add the text representation of this exception, but not its cause, to a stream.
+     *
+     * This is used by the Python interface, where the cause is reported by Python itself.
+     *
+     * @param[in] stream Reference to an output stream.
+     * @returns Reference to the output stream after adding the text.
+     */
+    std::ostream& addTracebackToStream(std::ostream& stream) const;
+
+    /**
+     * Return the text that addTracebackToStream() adds to a stream.
+     *
+     * The text is formatted the first time it is needed and kept, shared with copies, until the
+     * exception is modified, so asking for it repeatedly (as logging and test frameworks do of str()
+     * in Python) is cheap.  It is safe to call from several threads at once.
+     *
+     * @returns The exception's messages, tracepoints and type.
+     */
+    std::string asString(void) const;
+
     /**
      * Return a character string summarizing this exception.
      *
@@ -183,8 +634,18 @@ public:
     virtual Exception* clone(void) const;
 
 private:
-    std::string _message;
-    Traceback _traceback;
+    struct Payload;
+
+    // Return the payload for modification, first copying it if it is shared with other exceptions, or
+    // creating it if this is a lightweight exception.
+    Payload& _mutablePayload();
+
+    // Shared between copies until modified.  The reference count is kept in the Payload (rather than
+    // using std::shared_ptr) so that this header does not need <memory>.  Null for a lightweight
+    // exception, which only has a site and a static message.
+    Payload* _payload;
+    TracepointSite const* _lightSite;  // Only used while _payload is null
+    char const* _lightMessage;         // Only used while _payload is null
 };
 
 /**
@@ -195,6 +656,33 @@ private:
  * @returns Reference to the output stream after adding the text.
  */
 std::ostream& operator<<(std::ostream& stream, Exception const& e);
+
+namespace detail {
+
+/**
+ * For internal use by LSST_EXCEPT, LSST_EXCEPT_ERRNO, LSST_EXCEPT_FROM and the check macros; create an
+ * exception at a site.
+ *
+ * Subclasses whose constructors take a file, line and function (@ref LSST_EARGS_TYPED) rather than a
+ * site are passed the site's location.
+ */
+template <typename T, typename... Args>
+T construct(TracepointSite const* site, Args&&... args) {
+    if constexpr (std::is_constructible<T, TracepointSite const*, Args&&...>::value) {
+        return T(site, std::forward<Args>(args)...);
+    } else {
+        return T(site->getFile(), site->_line, site->getFunction(), std::forward<Args>(args)...);
+    }
+}
+
+/// For internal use by LSST_EXCEPT_FROM; attach a cause to an exception and return it.
+template <typename T>
+T withCause(T exception, std::exception_ptr cause) {
+    exception.setCause(std::move(cause));
+    return exception;
+}
+
+}  // namespace detail
 }
 }  // namespace pex
 }  // namespace lsst
@@ -0,0 +1,58 @@
+/*
+ * This file is part of pex_exceptions.
+ *
+ * Developed for the LSST Data Management System.
+ * This product includes software developed by the LSST Project
+ * (https://www.lsst.org).
+ * See the COPYRIGHT file at the top-level directory of this distribution
+ * for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef LSST_PEX_EXCEPTIONS_EXCEPTIONFWD_H
+#define LSST_PEX_EXCEPTIONS_EXCEPTIONFWD_H
+
+/*
+ * Forward declarations of the exception classes, for headers that only need to name them (e.g. in
+ * function declarations or as friends).  Include Exception.h or Runtime.h to throw or catch them.
+ */
+
+namespace lsst {
+namespace pex {
+namespace exceptions {
+
+struct TracepointSite;
+struct Tracepoint;
+struct StaticMessage;
+class Exception;
+
+class LogicError;
+class DomainError;
+class InvalidParameterError;
+class LengthError;
+class OutOfRangeError;
+class RuntimeError;
+class RangeError;
+class OverflowError;
+class UnderflowError;
+class NotFoundError;
+class IoError;
+class TypeError;
+
+}  // namespace exceptions
+}  // namespace pex
+}  // namespace lsst
+
+#endif
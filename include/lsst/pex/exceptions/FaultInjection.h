@@ -0,0 +1,132 @@
+/*
+ * This file is part of pex_exceptions.
+ *
+ * Developed for the LSST Data Management System.
+ * This product includes software developed by the LSST Project
+ * (https://www.lsst.org).
+ * See the COPYRIGHT file at the top-level directory of this distribution
+ * for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef LSST_PEX_EXCEPTIONS_FAULTINJECTION_H
+#define LSST_PEX_EXCEPTIONS_FAULTINJECTION_H
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "lsst/base.h"
+#include "lsst/pex/exceptions/ExceptionFwd.h"
+
+namespace lsst {
+namespace pex {
+namespace exceptions {
+
+/*
+ * Fault injection makes chosen check sites (LSST_INJECT_FAULT, and the macros in asserts.h in code
+ * compiled with LSST_EXCEPT_CHECK_FAULTS defined) throw even though their check passed, so that error
+ * paths can be tested and benchmarked at realistic failure rates without building broken inputs.  Sites
+ * are selected by rules, which can be set with setFaultRules() or, at startup, from the
+ * LSST_EXCEPT_FAULTS environment variable; see parseFaultRules() for the syntax.
+ *
+ * While no rules are set, each such site pays for one relaxed atomic load and a predictable branch.
+ * Defining LSST_EXCEPT_NO_FAULT_INJECTION before including asserts.h removes even that.
+ *
+ * Rules that could never match a site, such as one whose type is not a class name, are rejected when
+ * they are parsed or set.  Sites compiled with LSST_EXCEPT_SITE_IDS only match a rule's file once their
+ * site map is loaded (see SiteMap.h); until then they are shown as `<site 0x...>`, and a `site` field
+ * of that form selects them by fingerprint.
+ */
+
+/// A rule selecting check sites at which to inject faults, and how often.
+struct FaultRule {
+    /**
+     * Match sites whose file name ends with this path; empty to match any file.
+     *
+     * Sites compiled with LSST_EXCEPT_SITE_IDS only have a path once their site map is loaded (see
+     * SiteMap.h); until then they never match, and the first such site is reported on standard error.
+     */
+    std::string file;
+    /// Match sites on this line; 0 to match any line.
+    int line = 0;
+    /// Match the site with this fingerprint (TracepointSite::_hash); 0 to match any site.
+    std::uint64_t fingerprint = 0;
+    /// Match sites throwing this type, fully qualified or unqualified; empty to match any type.
+    std::string type;
+    /// Only consider every Nth matching call, starting with the Nth; 0 or 1 to consider every call.
+    std::uint64_t every = 0;
+    /// Probability that a considered call throws.
+    double probability = 1.0;
+    /// Seed for the pseudo-random sequence used with `probability`.
+    std::uint64_t seed = 0;
+};
+
+/**
+ * Parse a rule specification.
+ *
+ * Rules are separated by semicolons; each is a comma-separated list of `key=value` fields with keys
+ * `site` (`file`, `file:line` or `<site 0x...>`), `fingerprint`, `type`, `every`, `probability` and
+ * `seed`, e.g.
+ *
+ *     site=Fit.cc:212,probability=0.05,seed=42;type=LengthError,every=100
+ *
+ * @param[in] spec The rule specification.
+ *
+ * @throws InvalidParameterError Thrown if `spec` cannot be parsed, or a rule could never match.
+ */
+LSST_EXPORT std::vector<FaultRule> parseFaultRules(std::string const& spec);
+
+/**
+ * Replace the fault injection rules, and restart every rule's call count and random sequence.
+ *
+ * With the same rules, seeds and sequence of calls at each matching site, the same calls throw.
+ *
+ * @param[in] rules The new rules; an empty list turns fault injection off.
+ *
+ * @throws InvalidParameterError Thrown if a rule could never match; the previous rules are kept.
+ */
+LSST_EXPORT void setFaultRules(std::vector<FaultRule> const& rules);
+
+/**
+ * Replace the fault injection rules with ones parsed from a specification.
+ *
+ * @param[in] spec The rule specification; see parseFaultRules().
+ *
+ * @throws InvalidParameterError Thrown if `spec` cannot be parsed, or a rule could never match.
+ */
+LSST_EXPORT void setFaultRules(std::string const& spec);
+
+/// Turn fault injection off by removing all rules.
+LSST_EXPORT void clearFaultRules();
+
+/// Return the number of faults injected since the rules were last set.
+LSST_EXPORT std::uint64_t getInjectedFaultCount() noexcept;
+
+namespace detail {
+
+/// For internal use by the check macros; true while any fault injection rule is set.
+LSST_EXPORT extern std::atomic<bool> faultInjectionEnabled;
+
+/// For internal use by the check macros; decide whether this call at `site` should throw.
+LSST_EXPORT bool shouldInjectFault(TracepointSite const* site) noexcept;
+
+}  // namespace detail
+}  // namespace exceptions
+}  // namespace pex
+}  // namespace lsst
+
+#endif
@@ -0,0 +1,106 @@
+/*
+ * This file is part of pex_exceptions.
+ *
+ * Developed for the LSST Data Management System.
+ * This product includes software developed by the LSST Project
+ * (https://www.lsst.org).
+ * See the COPYRIGHT file at the top-level directory of this distribution
+ * for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef LSST_PEX_EXCEPTIONS_FLIGHTRECORDER_H
+#define LSST_PEX_EXCEPTIONS_FLIGHTRECORDER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "lsst/base.h"
+#include "lsst/pex/exceptions/ExceptionFwd.h"
+
+namespace lsst {
+namespace pex {
+namespace exceptions {
+
+/*
+ * The flight recorder is a fixed-size, process-wide ring buffer holding a small record of each
+ * of the most recently created exceptions, including ones that were caught and discarded without
+ * ever being logged.  Writing a record takes no locks and does not allocate.
+ *
+ * It is enabled by default; set the environment variable LSST_EXCEPT_FLIGHT_RECORDER=0 to disable it
+ * from the start, or call setFlightRecorderEnabled().
+ */
+
+/// The number of records kept by the flight recorder.
+std::size_t const FLIGHT_RECORDER_CAPACITY = 256;
+
+/// The maximum number of message characters kept in each flight recorder entry.
+std::size_t const FLIGHT_RECORDER_MESSAGE_LENGTH = 63;
+
+/// A copy of one flight recorder entry.
+struct ExceptionRecord {
+    std::int64_t timestamp;  ///< Creation time, in nanoseconds since the Unix epoch.
+    std::string type;        ///< C++ type of the exception; empty if not known.
+    std::string file;        ///< File where the exception was created; empty if not known.
+    int line;                ///< Line where the exception was created.
+    std::string function;    ///< Function where the exception was created.
+    std::string message;     ///< The start of the message.
+};
+
+/**
+ * Return the most recently created exceptions, oldest first.
+ *
+ * @param[in] n Maximum number of records to return.
+ */
+LSST_EXPORT std::vector<ExceptionRecord> getRecentExceptions(std::size_t n = FLIGHT_RECORDER_CAPACITY);
+
+/**
+ * Write the most recently created exceptions to a file descriptor, one per line, oldest first.
+ *
+ * This is async-signal-safe, so it can be called from a signal handler; type names are therefore
+ * printed in mangled form.
+ *
+ * @param[in] fd File descriptor to write to.
+ * @param[in] n Maximum number of records to write.
+ */
+LSST_EXPORT void dumpRecentExceptions(int fd, std::size_t n = FLIGHT_RECORDER_CAPACITY) noexcept;
+
+/// Turn the flight recorder on or off.  Turning it off does not clear existing records.
+LSST_EXPORT void setFlightRecorderEnabled(bool enabled) noexcept;
+
+/// Return whether the flight recorder is on.
+LSST_EXPORT bool isFlightRecorderEnabled() noexcept;
+
+/**
+ * Install handlers for SIGSEGV, SIGBUS, SIGILL, SIGFPE and SIGABRT that dump the flight recorder to
+ * standard error, then pass the signal on to the previously installed handler.
+ *
+ * Only the first call has any effect.
+ */
+LSST_EXPORT void installFlightRecorderSignalHandlers();
+
+namespace detail {
+
+/// For internal use by Exception; add an entry to the flight recorder.
+void recordException(TracepointSite const* site, std::string const& message) noexcept;
+
+}  // namespace detail
+}  // namespace exceptions
+}  // namespace pex
+}  // namespace lsst
+
+#endif
@@ -0,0 +1,64 @@
+/*
+ * This file is part of pex_exceptions.
+ *
+ * Developed for the LSST Data Management System.
+ * This product includes software developed by the LSST Project
+ * (https://www.lsst.org).
+ * See the COPYRIGHT file at the top-level directory of this distribution
+ * for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef LSST_PEX_EXCEPTIONS_GAUGES_H
+#define LSST_PEX_EXCEPTIONS_GAUGES_H
+
+#include <cstddef>
+
+#include "lsst/base.h"
+
+namespace lsst {
+namespace pex {
+namespace exceptions {
+
+/*
+ * Process-wide gauges of the exceptions currently alive, for attributing memory held by stored
+ * exceptions (for example in std::exception_ptr or in Python result lists).  They are kept with
+ * relaxed atomic updates when the message and traceback of an exception are created, modified and
+ * destroyed, so a reading taken while other threads create or destroy exceptions is only
+ * approximate.  Copies of an exception share its message and traceback until one of them is
+ * modified, so copying an exception does not touch the gauges, and copies are not counted.
+ *
+ * Building the library with -DLSST_EXCEPT_NO_GAUGES removes the updates; the gauges then read zero.
+ * Exception::memoryFootprint() is available either way.
+ */
+
+/// Return the number of distinct exceptions (not counting unmodified copies) currently alive.
+LSST_EXPORT std::size_t getLiveExceptionCount() noexcept;
+
+/**
+ * Return the number of bytes held by the messages and tracebacks of all live exceptions.
+ *
+ * Causes are counted as exceptions in their own right.
+ */
+LSST_EXPORT std::size_t getLiveExceptionBytes() noexcept;
+
+/// Return whether the library was built with the gauges (that is, without LSST_EXCEPT_NO_GAUGES).
+LSST_EXPORT bool hasExceptionGauges() noexcept;
+
+}  // namespace exceptions
+}  // namespace pex
+}  // namespace lsst
+
+#endif
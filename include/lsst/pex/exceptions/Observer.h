@@ -0,0 +1,100 @@
+/*
+ * This file is part of pex_exceptions.
+ *
+ * Developed for the LSST Data Management System.
+ * This product includes software developed by the LSST Project
+ * (https://www.lsst.org).
+ * See the COPYRIGHT file at the top-level directory of this distribution
+ * for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef LSST_PEX_EXCEPTIONS_OBSERVER_H
+#define LSST_PEX_EXCEPTIONS_OBSERVER_H
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+
+#include "lsst/base.h"
+#include "lsst/pex/exceptions/ExceptionFwd.h"
+
+namespace lsst {
+namespace pex {
+namespace exceptions {
+
+/*
+ * Observers are callbacks run whenever an exception gains a Tracepoint: when it is constructed with a
+ * source location (e.g. by LSST_EXCEPT) and when LSST_EXCEPT_ADD is called on it.  They are meant for
+ * profilers, tracers and test probes.  While no observer is registered, the only cost to exception code
+ * is one relaxed atomic load.
+ *
+ * Observers may be added and removed at any time, including while other threads are throwing.  They
+ * are called on the thread that creates or modifies the exception, possibly on several threads at once,
+ * and so must be thread-safe.  Exceptions thrown by an observer are ignored, and exceptions created
+ * inside an observer are not themselves observed.
+ */
+
+/// The event an exception observer is being notified of.
+enum class ExceptionEvent {
+    CONSTRUCTED,   ///< The exception is being constructed with a source location.
+    MESSAGE_ADDED  ///< A message has been added to the exception.
+};
+
+/**
+ * Callback type for exception observers.
+ *
+ * The arguments are the exception, the Tracepoint that was just added to it, and the event.  CONSTRUCTED
+ * is reported from the Exception constructors that record a location, however they are called, so the
+ * exception is only constructed as far as the Exception base class and its virtual functions report
+ * Exception; the type being constructed is `tracepoint._site->_type`, if the site records it (as for
+ * LSST_EXCEPT and the other macros that create exceptions).  Exceptions constructed with only a message
+ * (including from Python), and lightweight exceptions, have no tracepoint and are only reported when a
+ * message is added.  Neither argument may be used after the observer returns.
+ */
+typedef std::function<void(Exception const&, Tracepoint const&, ExceptionEvent)> ExceptionObserver;
+
+/**
+ * Register an exception observer.
+ *
+ * @param[in] observer Callback to run; must not be empty.
+ * @returns an identifier for removeExceptionObserver.
+ */
+LSST_EXPORT std::size_t addExceptionObserver(ExceptionObserver observer);
+
+/**
+ * Unregister an exception observer.
+ *
+ * A call already in progress on another thread may still be running when this returns.
+ *
+ * @param[in] id Identifier returned by addExceptionObserver.
+ * @returns true if the observer was registered.
+ */
+LSST_EXPORT bool removeExceptionObserver(std::size_t id);
+
+namespace detail {
+
+/// For internal use by Exception; true while at least one observer is registered.
+extern std::atomic<bool> observersActive;
+
+/// For internal use by Exception; run all registered observers.
+void notifyObservers(Exception const& exception, Tracepoint const& tracepoint, ExceptionEvent event) noexcept;
+
+}  // namespace detail
+}  // namespace exceptions
+}  // namespace pex
+}  // namespace lsst
+
+#endif
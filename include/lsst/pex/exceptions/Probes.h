@@ -0,0 +1,115 @@
+/*
+ * This file is part of pex_exceptions.
+ *
+ * Developed for the LSST Data Management System.
+ * This product includes software developed by the LSST Project
+ * (https://www.lsst.org).
+ * See the COPYRIGHT file at the top-level directory of this distribution
+ * for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef LSST_PEX_EXCEPTIONS_PROBES_H
+#define LSST_PEX_EXCEPTIONS_PROBES_H
+
+#include "lsst/base.h"
+
+namespace lsst {
+namespace pex {
+namespace exceptions {
+
+/*
+ * USDT (SystemTap-style statically defined tracing) probes, for following exceptions with perf,
+ * bpftrace or SystemTap without attaching uprobes to mangled constructor names.  When the library is
+ * built with -DLSST_EXCEPT_USDT ("scons usdt=1") on an x86-64 or AArch64 ELF platform, it has two
+ * probes in the provider lsst_pex_exceptions:
+ *
+ *  - `created`, in the constructors of Exception, and
+ *  - `message_added`, in Exception::addMessage,
+ *
+ * each with the arguments
+ *
+ *  1. the mangled name of the exception type (std::type_info::name()), or null if it is not known (in
+ *     the constructor, only sites created by LSST_EXCEPT and LSST_EXCEPT_LIGHT record the type);
+ *  2. the file, or null if the tracepoint has none or only has a site ID (see @ref secExcSiteIds);
+ *  3. the line, as an int;
+ *  4. the function, or null as for the file;
+ *  5. the message, as a null-terminated string.
+ *
+ * For example:
+ *
+ *     bpftrace -e 'usdt:/path/to/libpex_exceptions.so:lsst_pex_exceptions:created
+ *                  { printf("%s:%d %s\n", str(arg1), arg2, str(arg4)); }'
+ *
+ * A probe that no tracer is attached to costs a nop, and loading its arguments into registers.
+ */
+
+/// Return whether the library was built with USDT probes (see lsst/pex/exceptions/Probes.h).
+LSST_EXPORT bool hasExceptionProbes() noexcept;
+
+}  // namespace exceptions
+}  // namespace pex
+}  // namespace lsst
+
+#if defined(LSST_EXCEPT_USDT) && defined(__GNUC__) && defined(__ELF__) &&                                    \
+        (defined(__x86_64__) || defined(__aarch64__))
+#define LSST_EXCEPT_HAS_PROBES_ 1
+
+// For internal use; the asm operands and argument description of probe argument n.
+#define LSST_EXCEPT_PROBE_OPERAND_(n, value) [size##n] "n"(sizeof(value)), [arg##n] "nor"(value)
+#define LSST_EXCEPT_PROBE_ARG_(n) "%n[size" #n "]@%[arg" #n "]"
+
+/**
+ * For internal use; a USDT probe in the provider lsst_pex_exceptions, with five arguments.
+ *
+ * This emits a nop, and a note in the section .note.stapsdt describing where it is and where to find
+ * its arguments, as <sys/sdt.h> from SystemTap does (without depending on it).  The arguments are
+ * described as signed values of their size, in whatever register or memory location the compiler
+ * chose.
+ */
+#define LSST_EXCEPT_PROBE_(name, a1, a2, a3, a4, a5)                                                         \
+    __asm__ __volatile__("990: nop\n"                                                                        \
+                         ".pushsection .note.stapsdt,\"?\",\"note\"\n"                                       \
+                         ".balign 4\n"                                                                       \
+                         ".4byte 992f-991f, 994f-993f, 3\n"                                                  \
+                         "991: .asciz \"stapsdt\"\n"                                                         \
+                         "992: .balign 4\n"                                                                  \
+                         "993: .8byte 990b\n"                                                                \
+                         ".8byte _.stapsdt.base\n"                                                           \
+                         ".8byte 0\n" /* no semaphore */                                                     \
+                         ".asciz \"lsst_pex_exceptions\"\n"                                                  \
+                         ".asciz \"" #name "\"\n"                                                            \
+                         ".asciz \"" LSST_EXCEPT_PROBE_ARG_(1) " " LSST_EXCEPT_PROBE_ARG_(2) " "             \
+                         LSST_EXCEPT_PROBE_ARG_(3) " " LSST_EXCEPT_PROBE_ARG_(4) " "                         \
+                         LSST_EXCEPT_PROBE_ARG_(5) "\"\n"                                                    \
+                         "994: .balign 4\n"                                                                  \
+                         ".popsection\n"                                                                     \
+                         ".ifndef _.stapsdt.base\n"                                                          \
+                         ".pushsection .stapsdt.base,\"aG\",\"progbits\",.stapsdt.base,comdat\n"             \
+                         ".weak _.stapsdt.base\n"                                                            \
+                         ".hidden _.stapsdt.base\n"                                                          \
+                         "_.stapsdt.base: .space 1\n"                                                        \
+                         ".size _.stapsdt.base, 1\n"                                                         \
+                         ".popsection\n"                                                                     \
+                         ".endif\n"                                                                          \
+                         :                                                                                   \
+                         : LSST_EXCEPT_PROBE_OPERAND_(1, a1), LSST_EXCEPT_PROBE_OPERAND_(2, a2),             \
+                           LSST_EXCEPT_PROBE_OPERAND_(3, a3), LSST_EXCEPT_PROBE_OPERAND_(4, a4),             \
+                           LSST_EXCEPT_PROBE_OPERAND_(5, a5))
+#else
+#define LSST_EXCEPT_PROBE_(name, a1, a2, a3, a4, a5) static_cast<void>(0)
+#endif
+
+#endif
@@ -43,7 +43,7 @@ namespace exceptions {
  * @see RuntimeError
  * @see std::logic_error
  */
-LSST_EXCEPTION_TYPE(LogicError, Exception, lsst::pex::exceptions::LogicError)
+LSST_EXCEPTION_TYPE_DECL(LogicError, Exception, lsst::pex::exceptions::LogicError)
 
 /**
  * Reports arguments outside the domain of an operation.
@@ -54,7 +54,7 @@ LSST_EXCEPTION_TYPE(LogicError, Exception, lsst::pex::exceptions::LogicError)
  *
  * @see std::domain_error
  */
-LSST_EXCEPTION_TYPE(DomainError, LogicError, lsst::pex::exceptions::DomainError)
+LSST_EXCEPTION_TYPE_DECL(DomainError, LogicError, lsst::pex::exceptions::DomainError)
 
 /**
  * Reports invalid arguments.
@@ -63,7 +63,7 @@ LSST_EXCEPTION_TYPE(DomainError, LogicError, lsst::pex::exceptions::DomainError)
  *
  * @see std::invalid_argument
  */
-LSST_EXCEPTION_TYPE(InvalidParameterError, LogicError, lsst::pex::exceptions::InvalidParameterError)
+LSST_EXCEPTION_TYPE_DECL(InvalidParameterError, LogicError, lsst::pex::exceptions::InvalidParameterError)
 
 /**
  * Reports attempts to exceed implementation-defined length limits for some classes.
@@ -73,7 +73,7 @@ LSST_EXCEPTION_TYPE(InvalidParameterError, LogicError, lsst::pex::exceptions::In
  *
  * @see std::length_error
  */
-LSST_EXCEPTION_TYPE(LengthError, LogicError, lsst::pex::exceptions::LengthError)
+LSST_EXCEPTION_TYPE_DECL(LengthError, LogicError, lsst::pex::exceptions::LengthError)
 
 /**
  * Reports attempts to access elements outside a valid range of indices.
@@ -86,7 +86,7 @@ LSST_EXCEPTION_TYPE(LengthError, LogicError, lsst::pex::exceptions::LengthError)
  * for exceptions that are exactly `IndexError` rather than a
  * sub- or superclass.
  */
-LSST_EXCEPTION_TYPE(OutOfRangeError, LogicError, lsst::pex::exceptions::OutOfRangeError)
+LSST_EXCEPTION_TYPE_DECL(OutOfRangeError, LogicError, lsst::pex::exceptions::OutOfRangeError)
 
 /**
  * Reports errors that are due to events beyond the control of the program.
@@ -101,7 +101,7 @@ LSST_EXCEPTION_TYPE(OutOfRangeError, LogicError, lsst::pex::exceptions::OutOfRan
  * @see LogicError
  * @see std::runtime_error
  */
-LSST_EXCEPTION_TYPE(RuntimeError, Exception, lsst::pex::exceptions::RuntimeError)
+LSST_EXCEPTION_TYPE_DECL(RuntimeError, Exception, lsst::pex::exceptions::RuntimeError)
 
 /**
  * Reports when the result of an operation cannot be represented by the destination type.
@@ -112,7 +112,7 @@ LSST_EXCEPTION_TYPE(RuntimeError, Exception, lsst::pex::exceptions::RuntimeError
  * @see UnderflowError
  * @see std::range_error
  */
-LSST_EXCEPTION_TYPE(RangeError, RuntimeError, lsst::pex::exceptions::RangeError)
+LSST_EXCEPTION_TYPE_DECL(RangeError, RuntimeError, lsst::pex::exceptions::RangeError)
 
 /**
  * Reports when the result of an arithmetic operation is too large for the destination type.
@@ -121,7 +121,7 @@ LSST_EXCEPTION_TYPE(RangeError, RuntimeError, lsst::pex::exceptions::RangeError)
  *
  * @see std::overflow_error
  */
-LSST_EXCEPTION_TYPE(OverflowError, RuntimeError, lsst::pex::exceptions::OverflowError)
+LSST_EXCEPTION_TYPE_DECL(OverflowError, RuntimeError, lsst::pex::exceptions::OverflowError)
 
 /**
  * Reports when the result of an arithmetic operation is too small for the destination type.
@@ -130,7 +130,7 @@ LSST_EXCEPTION_TYPE(OverflowError, RuntimeError, lsst::pex::exceptions::Overflow
  *
  * @see std::underflow_error
  */
-LSST_EXCEPTION_TYPE(UnderflowError, RuntimeError, lsst::pex::exceptions::UnderflowError)
+LSST_EXCEPTION_TYPE_DECL(UnderflowError, RuntimeError, lsst::pex::exceptions::UnderflowError)
 
 /**
  * Reports attempts to access elements using an invalid key.
@@ -148,7 +148,7 @@ LSST_EXCEPTION_TYPE(UnderflowError, RuntimeError, lsst::pex::exceptions::Underfl
  * for exceptions that are exactly `KeyError` rather than a
  * sub- or superclass.
  */
-LSST_EXCEPTION_TYPE(NotFoundError, Exception, lsst::pex::exceptions::NotFoundError)
+LSST_EXCEPTION_TYPE_DECL(NotFoundError, Exception, lsst::pex::exceptions::NotFoundError)
 
 /**
  * Reports errors in external input/output operations.
@@ -157,14 +157,14 @@ LSST_EXCEPTION_TYPE(NotFoundError, Exception, lsst::pex::exceptions::NotFoundErr
  *
  * @see std::ios_base::failure
  */
-LSST_EXCEPTION_TYPE(IoError, RuntimeError, lsst::pex::exceptions::IoError)
+LSST_EXCEPTION_TYPE_DECL(IoError, RuntimeError, lsst::pex::exceptions::IoError)
 
 /**
  * Reports errors from accepting an object of an unexpected or inappropriate type.
  *
  * In Python, this exception inherits from `builtins.TypeError`.
  */
-LSST_EXCEPTION_TYPE(TypeError, LogicError, lsst::pex::exceptions::TypeError)
+LSST_EXCEPTION_TYPE_DECL(TypeError, LogicError, lsst::pex::exceptions::TypeError)
 
 }  // namespace exceptions
 }  // namespace pex
@@ -0,0 +1,62 @@
+/*
+ * This file is part of pex_exceptions.
+ *
+ * Developed for the LSST Data Management System.
+ * This product includes software developed by the LSST Project
+ * (https://www.lsst.org).
+ * See the COPYRIGHT file at the top-level directory of this distribution
+ * for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef LSST_PEX_EXCEPTIONS_SITEMAP_H
+#define LSST_PEX_EXCEPTIONS_SITEMAP_H
+
+#include <string>
+
+#include "lsst/base.h"
+
+namespace lsst {
+namespace pex {
+namespace exceptions {
+
+/*
+ * Code compiled with -DLSST_EXCEPT_SITE_IDS (GCC-compatible compilers only) records a 64-bit ID for
+ * each LSST_EXCEPT and LSST_EXCEPT_ADD site instead of its file and function name, and the names are
+ * kept in a separate site map written at build time by python/lsst/pex/exceptions/siteMap.py.  When a
+ * site's file or function is needed (for example by Exception::addToStream or in Python), it is looked
+ * up in the site maps that have been loaded.  Those are:
+ *  - `<object>.sites`, next to the shared library or executable containing the site;
+ *  - the files listed in the environment variable LSST_EXCEPT_SITE_MAPS, separated by colons;
+ *  - files passed to loadSiteMap().
+ * Sites that are in none of them are shown by ID, as `<site 0x0123456789abcdef>`.
+ */
+
+/**
+ * Load a site map, adding its sites to those that can be looked up.
+ *
+ * If a site is in more than one map, the names loaded first are kept.
+ *
+ * @param[in] path Path of the site map.
+ *
+ * @throws IoError if the file cannot be read.
+ */
+LSST_EXPORT void loadSiteMap(std::string const& path);
+
+}  // namespace exceptions
+}  // namespace pex
+}  // namespace lsst
+
+#endif
@@ -0,0 +1,83 @@
+/*
+ * This file is part of pex_exceptions.
+ *
+ * Developed for the LSST Data Management System.
+ * This product includes software developed by the LSST Project
+ * (https://www.lsst.org).
+ * See the COPYRIGHT file at the top-level directory of this distribution
+ * for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef LSST_PEX_EXCEPTIONS_TERMINATE_H
+#define LSST_PEX_EXCEPTIONS_TERMINATE_H
+
+#include <cstddef>
+
+#include "lsst/base.h"
+
+namespace lsst {
+namespace pex {
+namespace exceptions {
+
+/*
+ * When an exception escapes a thread or a noexcept function, std::terminate at best prints its what()
+ * string, and the traceback of an LSST exception is lost.  The handlers here print the type, message,
+ * tracepoints and causes of the exception instead.
+ *
+ * The report is formatted into a preallocated static buffer, without iostreams, and written with a
+ * single write(2), so it does not depend on the state of the heap or of the standard streams.  The one
+ * step that cannot be made async-signal-safe is finding the current exception, which (as in
+ * libstdc++'s own verbose terminate handler) is done by rethrowing it.  Only the first report in a
+ * process is written, so the SIGABRT that follows std::terminate does not repeat it.
+ */
+
+/// The size of the buffer used by writeCurrentException(); longer reports are truncated.
+std::size_t const TERMINATE_REPORT_CAPACITY = 16384;
+
+/**
+ * Install a std::terminate handler that reports the current exception to standard error, then calls
+ * the previously installed handler.
+ */
+LSST_EXPORT void installTerminateHandler();
+
+/**
+ * Install handlers for SIGSEGV, SIGBUS, SIGILL, SIGFPE and SIGABRT that report the exception being
+ * handled by the crashing thread, if any, to standard error, then pass the signal on to the previously
+ * installed handler.
+ *
+ * This covers crashes inside catch blocks and aborts that do not go through std::terminate.
+ */
+LSST_EXPORT void installTerminateSignalHandlers();
+
+/**
+ * Write a report of the exception currently being handled by this thread to a file descriptor.
+ *
+ * LSST exceptions are reported with their traceback, in the same format as Exception::addToStream;
+ * other exceptions with their type and what() string.  This does not allocate memory, except that
+ * rethrowing an exception may, and formatting the description of an error code may the first time an
+ * exception's what() is called.
+ *
+ * @param[in] fd File descriptor to write to.
+ * @param[in] header Text to write before the report, such as the reason the program is stopping.
+ * @returns false if there is no current exception, or if another thread is writing a report.
+ */
+LSST_EXPORT bool writeCurrentException(int fd, char const* header = "") noexcept;
+
+}  // namespace exceptions
+}  // namespace pex
+}  // namespace lsst
+
+#endif
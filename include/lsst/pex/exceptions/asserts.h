@@ -21,9 +21,252 @@
  * along with this program.  If not, see <https://www.gnu.org/licenses/>.
  */
 
-#include "boost/format.hpp"
+#ifndef LSST_PEX_EXCEPTIONS_ASSERTS_H
+#define LSST_PEX_EXCEPTIONS_ASSERTS_H
+
+#include <cstddef>
+#include <iosfwd>
+#include <string>
+#include <type_traits>
 
 #include "lsst/pex/exceptions/Exception.h"
+#include "lsst/pex/exceptions/FaultInjection.h"
+#include "lsst/pex/exceptions/Runtime.h"
+
+/*
+ * The check macros below keep only a comparison and a predicted-not-taken branch at the call site.
+ * Everything needed to build the exception (formatting, the exception constructor, the throw
+ * itself) lives in a noinline, cold helper, so guarding a hot loop does not bloat it.  The
+ * compared values are evaluated exactly once and handed to the helper by value.
+ *
+ * Every check is also a fault injection point (see FaultInjection.h), as is LSST_INJECT_FAULT.
+ *
+ * The macros may also be used in constexpr functions.  When such a function is evaluated at compile
+ * time, a check that passes leaves no trace, and one that fails makes the expression non-constant, so
+ * that the compiler reports an error showing the check, its message and the values compared.  This
+ * needs __builtin_is_constant_evaluated (GCC 9, Clang 9 or later).
+ */
+
+#if defined(__GNUC__)
+/// For internal use; hints to the compiler that a check is expected to pass.
+#define LSST_EXCEPT_UNLIKELY(x) __builtin_expect(!!(x), 0)
+/// For internal use; marks a throw helper as rarely executed and keeps it out of line.
+#define LSST_EXCEPT_COLD __attribute__((noinline, cold))
+#else
+#define LSST_EXCEPT_UNLIKELY(x) (x)
+#define LSST_EXCEPT_COLD
+#endif
+
+#if defined(__has_builtin)
+#if __has_builtin(__builtin_is_constant_evaluated)
+/// For internal use; true during constant evaluation of a constexpr function.
+#define LSST_EXCEPT_CONSTANT_EVALUATED_() __builtin_is_constant_evaluated()
+#endif
+#elif defined(__GNUC__) && __GNUC__ >= 9
+#define LSST_EXCEPT_CONSTANT_EVALUATED_() __builtin_is_constant_evaluated()
+#endif
+#ifndef LSST_EXCEPT_CONSTANT_EVALUATED_
+#define LSST_EXCEPT_CONSTANT_EVALUATED_() false
+#endif
+
+namespace lsst {
+namespace pex {
+namespace exceptions {
+namespace detail {
+
+/**
+ * For internal use by the check macros; a compared value, type-erased so that the Boost.Format message
+ * can be built out of line without this header including Boost.Format or <ostream>.
+ *
+ * Arithmetic types, enums, strings and pointers are formatted as Boost.Format would format them
+ * directly; any other type is written with its `operator<<`.
+ */
+struct CheckValue {
+    enum Kind { SIGNED, UNSIGNED, FLOATING, CHARACTER, STRING, POINTER, OTHER };
+
+    Kind kind;
+    long long signedValue;
+    unsigned long long unsignedValue;
+    long double floatingValue;
+    char const *stringValue;
+    void const *pointerValue;  // also the object for OTHER
+    void (*write)(std::ostream &, void const *);  // writer for OTHER
+};
+
+/// For internal use by CheckValue; write an object of a type without a built-in conversion.
+template <typename T>
+void writeCheckValue(std::ostream &stream, void const *value) {
+    stream << *static_cast<T const *>(value);
+}
+
+/// For internal use by the check macros; wrap a value, which must outlive the result.
+template <typename T>
+CheckValue makeCheckValue(T const &value) noexcept {
+    CheckValue result = {CheckValue::OTHER, 0, 0, 0.0, nullptr, nullptr, nullptr};
+    if constexpr (std::is_same<T, char>::value || std::is_same<T, signed char>::value ||
+                  std::is_same<T, unsigned char>::value) {
+        result.kind = CheckValue::CHARACTER;
+        result.signedValue = static_cast<char>(value);
+    } else if constexpr (std::is_enum<T>::value) {
+        return makeCheckValue(static_cast<typename std::underlying_type<T>::type>(value));
+    } else if constexpr (std::is_integral<T>::value && std::is_signed<T>::value) {
+        result.kind = CheckValue::SIGNED;
+        result.signedValue = value;
+    } else if constexpr (std::is_integral<T>::value) {
+        result.kind = CheckValue::UNSIGNED;
+        result.unsignedValue = value;
+    } else if constexpr (std::is_floating_point<T>::value) {
+        result.kind = CheckValue::FLOATING;
+        result.floatingValue = value;
+    } else if constexpr (std::is_convertible<T const &, char const *>::value) {
+        result.kind = CheckValue::STRING;
+        result.stringValue = value;
+    } else if constexpr (std::is_same<T, std::string>::value) {
+        result.kind = CheckValue::STRING;
+        result.stringValue = value.c_str();
+    } else if constexpr (std::is_same<T, std::nullptr_t>::value) {
+        result.kind = CheckValue::STRING;
+        result.stringValue = "nullptr";
+    } else if constexpr (std::is_pointer<T>::value) {
+        result.kind = CheckValue::POINTER;
+        result.pointerValue = static_cast<void const *>(value);
+    } else {
+        result.pointerValue = &value;
+        result.write = &writeCheckValue<T>;
+    }
+    return result;
+}
+
+/// For internal use by the check macros; apply a Boost.Format string to two values.
+LSST_EXPORT std::string formatCheckMessage(char const *format, CheckValue const &n1, CheckValue const &n2);
+
+/// For internal use; apply a Boost.Format string to any number of values.
+LSST_EXPORT std::string formatCheckMessage(char const *format, CheckValue const *values, std::size_t nValues);
+
+/// For internal use by the check macros; throw EXC_CLASS with a message formatted from two values.
+template <typename EXC_CLASS, typename T1, typename T2>
+[[noreturn]] LSST_EXCEPT_COLD void throwFormatted(TracepointSite const *site, char const *format, T1 n1,
+                                                  T2 n2) {
+    throw construct<EXC_CLASS>(site, formatCheckMessage(format, makeCheckValue(n1), makeCheckValue(n2)));
+}
+
+/// For internal use by the check macros; throw EXC_CLASS with a fixed message.
+template <typename EXC_CLASS>
+[[noreturn]] LSST_EXCEPT_COLD void throwMessage(TracepointSite const *site, char const *message) {
+    throw construct<EXC_CLASS>(site, message);
+}
+
+/// For internal use by LSST_INJECT_FAULT; throw EXC_CLASS if fault injection selects this call.
+template <typename EXC_CLASS>
+LSST_EXCEPT_COLD void injectFault(TracepointSite const *site) {
+    if (shouldInjectFault(site)) {
+        throw construct<EXC_CLASS>(site, "Injected fault");
+    }
+}
+
+/// For internal use by constantCheckFailed; deliberately not constexpr.
+inline void checkFailedInConstantExpression() noexcept {}
+
+/**
+ * For internal use by the check macros; report a check that fails during constant evaluation.
+ *
+ * Evaluating this calls a function that is not constexpr, so the compiler rejects the constant
+ * expression, and shows this call (with the message and the values) in its error.
+ */
+template <typename... Values>
+constexpr bool constantCheckFailed(char const *message, Values const &...) noexcept {
+    if (message) checkFailedInConstantExpression();
+    return false;
+}
+
+/// For internal use by LSST_CHECK_INDEX; true if `i` is not a valid index into a sequence of size `n`.
+template <typename I, typename N>
+constexpr bool isIndexOutOfRange(I i, N n) noexcept {
+    static_assert(std::is_integral<I>::value && std::is_integral<N>::value,
+                  "LSST_CHECK_INDEX requires integral arguments");
+    if constexpr (std::is_signed<I>::value) {
+        if (i < 0) return true;
+    }
+    if constexpr (std::is_signed<N>::value) {
+        if (n < 0) return true;
+    }
+    return static_cast<unsigned long long>(i) >= static_cast<unsigned long long>(n);
+}
+
+}  // namespace detail
+}  // namespace exceptions
+}  // namespace pex
+}  // namespace lsst
+
+#ifdef LSST_EXCEPT_NO_FAULT_INJECTION
+#define LSST_EXCEPT_FAULTS_ENABLED_() false
+#else
+/// For internal use; true while fault injection rules are set.
+#define LSST_EXCEPT_FAULTS_ENABLED_() \
+    ::lsst::pex::exceptions::detail::faultInjectionEnabled.load(std::memory_order_relaxed)
+#endif
+
+/**
+ * Throw EXC_CLASS if fault injection selects this call, and do nothing otherwise.
+ *
+ * The check macros below do the same when their check passes, if LSST_EXCEPT_CHECK_FAULTS is defined;
+ * use this directly to make other failure points testable.  While no rules are set it costs one relaxed
+ * atomic load and a predictable branch.  For example:
+ *
+ *     LSST_INJECT_FAULT(IoError);
+ */
+#define LSST_INJECT_FAULT(EXC_CLASS)                                                                         \
+    do {                                                                                                     \
+        if (!LSST_EXCEPT_CONSTANT_EVALUATED_() && LSST_EXCEPT_UNLIKELY(LSST_EXCEPT_FAULTS_ENABLED_())) {     \
+            ::lsst::pex::exceptions::detail::injectFault<EXC_CLASS>(LSST_EXCEPT_TYPED_HERE(EXC_CLASS));      \
+        }                                                                                                    \
+    } while (false)
+
+/*
+ * The check macros below only give fault injection a chance at their sites if LSST_EXCEPT_CHECK_FAULTS is
+ * defined when they are compiled; it is a build option (for this package, "scons checkFaults=1"), to be
+ * set for a whole package rather than in individual files.  Even while no rules are set, the atomic load
+ * and the call that may return make the compiler reload everything a loop has in memory after each check,
+ * which costs tight loops far more than the check itself.
+ */
+#if defined(LSST_EXCEPT_CHECK_FAULTS) && !defined(LSST_EXCEPT_NO_FAULT_INJECTION)
+#define LSST_EXCEPT_CHECK_FAULT_(EXC_CLASS) LSST_INJECT_FAULT(EXC_CLASS)
+#else
+#define LSST_EXCEPT_CHECK_FAULT_(EXC_CLASS)                                                                  \
+    do {                                                                                                     \
+    } while (false)
+#endif
+
+/**
+ * For internal use; if FAILED, evaluate CONSTANT_FAILURE during constant evaluation and THROW (which may
+ * use lsstCheckSite) otherwise, and give fault injection its chance if not (see above).
+ */
+#define LSST_EXCEPT_CHECK_(FAILED, EXC_CLASS, CONSTANT_FAILURE, THROW)                                       \
+    do {                                                                                                     \
+        bool const lsstCheckFailed = (FAILED);                                                               \
+        if (LSST_EXCEPT_CONSTANT_EVALUATED_()) {                                                             \
+            if (lsstCheckFailed) CONSTANT_FAILURE;                                                           \
+        } else if (LSST_EXCEPT_UNLIKELY(lsstCheckFailed)) {                                                  \
+            ::lsst::pex::exceptions::TracepointSite const *const lsstCheckSite =                             \
+                    LSST_EXCEPT_TYPED_HERE(EXC_CLASS);                                                       \
+            THROW;                                                                                           \
+        } else {                                                                                             \
+            LSST_EXCEPT_CHECK_FAULT_(EXC_CLASS);                                                             \
+        }                                                                                                    \
+    } while (false)
+
+/// For internal use; throw EXC_CLASS from the cold path if `N1 OP N2` holds.
+#define LSST_EXCEPT_THROW_IF_(N1, OP, N2, EXC_CLASS, MSG)                                                    \
+    do {                                                                                                     \
+        auto const lsstCheckN1 = (N1);                                                                       \
+        auto const lsstCheckN2 = (N2);                                                                       \
+        LSST_EXCEPT_CHECK_(lsstCheckN1 OP lsstCheckN2, EXC_CLASS,                                            \
+                           ::lsst::pex::exceptions::detail::constantCheckFailed(MSG, lsstCheckN1,            \
+                                                                                lsstCheckN2),                \
+                           ::lsst::pex::exceptions::detail::throwFormatted<EXC_CLASS>(lsstCheckSite, MSG,    \
+                                                                                      lsstCheckN1,           \
+                                                                                      lsstCheckN2));         \
+    } while (false)
 
 /**
  * Check whether the given values are equal, and throw an LSST Exception if they are not.
@@ -35,5 +278,65 @@
  *     LSST_THROW_IF_NE(3, 4, LengthError, "size of foo (%d) is not equal to size of bar (%d)");
  *
  */
-#define LSST_THROW_IF_NE(N1, N2, EXC_CLASS, MSG) \
-    if ((N1) != (N2)) throw LSST_EXCEPT(EXC_CLASS, (boost::format(MSG) % (N1) % (N2)).str())
+#define LSST_THROW_IF_NE(N1, N2, EXC_CLASS, MSG) LSST_EXCEPT_THROW_IF_(N1, !=, N2, EXC_CLASS, MSG)
+
+/// Throw EXC_CLASS if `N1 == N2`; MSG takes two Boost.Format placeholders, as for LSST_THROW_IF_NE.
+#define LSST_THROW_IF_EQ(N1, N2, EXC_CLASS, MSG) LSST_EXCEPT_THROW_IF_(N1, ==, N2, EXC_CLASS, MSG)
+
+/// Throw EXC_CLASS if `N1 < N2`; MSG takes two Boost.Format placeholders, as for LSST_THROW_IF_NE.
+#define LSST_THROW_IF_LT(N1, N2, EXC_CLASS, MSG) LSST_EXCEPT_THROW_IF_(N1, <, N2, EXC_CLASS, MSG)
+
+/// Throw EXC_CLASS if `N1 <= N2`; MSG takes two Boost.Format placeholders, as for LSST_THROW_IF_NE.
+#define LSST_THROW_IF_LE(N1, N2, EXC_CLASS, MSG) LSST_EXCEPT_THROW_IF_(N1, <=, N2, EXC_CLASS, MSG)
+
+/// Throw EXC_CLASS if `N1 > N2`; MSG takes two Boost.Format placeholders, as for LSST_THROW_IF_NE.
+#define LSST_THROW_IF_GT(N1, N2, EXC_CLASS, MSG) LSST_EXCEPT_THROW_IF_(N1, >, N2, EXC_CLASS, MSG)
+
+/// Throw EXC_CLASS if `N1 >= N2`; MSG takes two Boost.Format placeholders, as for LSST_THROW_IF_NE.
+#define LSST_THROW_IF_GE(N1, N2, EXC_CLASS, MSG) LSST_EXCEPT_THROW_IF_(N1, >=, N2, EXC_CLASS, MSG)
+
+/**
+ * Check that an integer is a valid index into a sequence, and throw OutOfRangeError if it is not.
+ *
+ * Negative indices are always out of range.  For example:
+ *
+ *     LSST_CHECK_INDEX(i, vec.size());
+ */
+#define LSST_CHECK_INDEX(I, N)                                                                               \
+    do {                                                                                                     \
+        auto const lsstCheckI = (I);                                                                         \
+        auto const lsstCheckN = (N);                                                                         \
+        LSST_EXCEPT_CHECK_(::lsst::pex::exceptions::detail::isIndexOutOfRange(lsstCheckI, lsstCheckN),       \
+                           ::lsst::pex::exceptions::OutOfRangeError,                                         \
+                           ::lsst::pex::exceptions::detail::constantCheckFailed(                             \
+                                   "Index %d out of range for size %d", lsstCheckI, lsstCheckN),             \
+                           ::lsst::pex::exceptions::detail::throwFormatted<                                  \
+                                   ::lsst::pex::exceptions::OutOfRangeError>(                                \
+                                   lsstCheckSite, "Index %d out of range for size %d", lsstCheckI,           \
+                                   lsstCheckN));                                                             \
+    } while (false)
+
+/**
+ * Check that a pointer is not null, and throw an LSST Exception with a fixed message if it is.
+ *
+ * For example:
+ *
+ *     LSST_CHECK_NOT_NULL(psf, InvalidParameterError, "no PSF attached to exposure");
+ */
+#define LSST_CHECK_NOT_NULL(PTR, EXC_CLASS, MSG)                                                             \
+    LSST_EXCEPT_CHECK_((PTR) == nullptr, EXC_CLASS,                                                          \
+                       ::lsst::pex::exceptions::detail::constantCheckFailed(MSG),                            \
+                       ::lsst::pex::exceptions::detail::throwMessage<EXC_CLASS>(lsstCheckSite, MSG))
+
+/**
+ * Check that a condition holds, and throw an LSST Exception with a fixed message if it does not.
+ *
+ * For example:
+ *
+ *     LSST_CHECK(width % 2 == 1, InvalidParameterError, "kernel width must be odd");
+ */
+#define LSST_CHECK(COND, EXC_CLASS, MSG)                                                                     \
+    LSST_EXCEPT_CHECK_(!(COND), EXC_CLASS, ::lsst::pex::exceptions::detail::constantCheckFailed(MSG),        \
+                       ::lsst::pex::exceptions::detail::throwMessage<EXC_CLASS>(lsstCheckSite, MSG))
+
+#endif
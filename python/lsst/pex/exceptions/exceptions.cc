@@ -22,15 +22,27 @@
  */
 
 #include "pybind11/pybind11.h"
+#include "pybind11/stl.h"
 
+#include <memory>
 #include <sstream>
+#include <system_error>
+#include <typeinfo>
 
 #include "lsst/pex/exceptions/Exception.h"
+#include "lsst/pex/exceptions/FaultInjection.h"
+#include "lsst/pex/exceptions/FlightRecorder.h"
+#include "lsst/pex/exceptions/Gauges.h"
+#include "lsst/pex/exceptions/Observer.h"
+#include "lsst/pex/exceptions/Probes.h"
 #include "lsst/pex/exceptions/Runtime.h"
+#include "lsst/pex/exceptions/SiteMap.h"
+#include "lsst/pex/exceptions/Terminate.h"
 
 using namespace lsst::pex::exceptions;
 
 namespace py = pybind11;
+using namespace pybind11::literals;
 
 namespace lsst {
 namespace pex {
@@ -46,8 +58,14 @@ void tryLsstExceptionWarn(const char *message) {
     }
 }
 
+// Maximum number of causes translated with an exception, in case of a cycle (an exception can be given
+// itself as its cause).
+int const MAX_CAUSES = 16;
+
+py::object translateCause(std::exception_ptr cause, int depth);
+
 /**
- * Raise a Python exception that wraps the given C++ exception instance.
+ * Create a Python exception that wraps the given C++ exception instance.
  *
  * Most of the work is delegated to the pure-Python function pex.exceptions.wrappers.translate(),
  * which looks up the appropriate Python exception class from a dict that maps C++ exception
@@ -55,35 +73,126 @@ void tryLsstExceptionWarn(const char *message) {
  * module, preparing the arguments, and calling that function, along with the very verbose error
  * handling required by the Python C API.
  *
- * If any point we fail to translate the exception, we print a Python warning and raise the built-in
- * Python RuntimeError exception with the same message as the C++ exception.
+ * If the C++ exception has a cause, it is translated too and set as the `__cause__` of the result.
  *
- * @param pyex a wrapped instance of pex::exceptions::Exception
+ * @param e the C++ exception to translate
+ * @param depth how far down a chain of causes `e` is (0 for the exception being raised)
+ * @param wrappedClass the bound C++ class to translate `e` as, if not its own (see makePythonObserver)
+ * @returns the Python exception, or a null object (after printing a Python warning) if the
+ *          translation failed
  */
-void raiseLsstException(py::object &pyex) {
+py::object translateLsstException(Exception const &e, int depth = 0, py::handle wrappedClass = py::handle()) {
     static auto module =
             py::reinterpret_borrow<py::object>(PyImport_ImportModule("lsst.pex.exceptions.wrappers"));
     if (!module.ptr()) {
         tryLsstExceptionWarn("Failed to import C++ Exception wrapper module.");
-    } else {
-        static auto translate =
-                py::reinterpret_borrow<py::object>(PyObject_GetAttrString(module.ptr(), "translate"));
-        if (!translate.ptr()) {
-            tryLsstExceptionWarn("Failed to find translation function for C++ Exceptions.");
-        } else {
-            // Calling the Python translate() returns an instance of the appropriate Python
-            // exception that wraps the C++ exception instance that we give it.
-            auto instance = py::reinterpret_steal<py::object>(
-                    PyObject_CallFunctionObjArgs(translate.ptr(), pyex.ptr(), NULL));
-            if (!instance.ptr()) {
-                // We actually expect a null return here, as translate() should raise an exception
-                tryLsstExceptionWarn("Failed to translate C++ Exception to Python.");
-            } else {
-                auto type = py::reinterpret_borrow<py::object>(PyObject_Type(instance.ptr()));
-                PyErr_SetObject(type.ptr(), instance.ptr());
-            }
+        return py::object();
+    }
+    static auto translate =
+            py::reinterpret_borrow<py::object>(PyObject_GetAttrString(module.ptr(), "translate"));
+    if (!translate.ptr()) {
+        tryLsstExceptionWarn("Failed to find translation function for C++ Exceptions.");
+        return py::object();
+    }
+    // Calling the Python translate() returns an instance of the appropriate Python
+    // exception that wraps the C++ exception instance that we give it.
+    py::object pyex = py::cast(e.clone(), py::return_value_policy::take_ownership);
+    auto instance = py::reinterpret_steal<py::object>(
+            wrappedClass ? PyObject_CallFunctionObjArgs(translate.ptr(), pyex.ptr(), wrappedClass.ptr(), NULL)
+                         : PyObject_CallFunctionObjArgs(translate.ptr(), pyex.ptr(), NULL));
+    if (!instance.ptr()) {
+        // We actually expect a null return here, as translate() should raise an exception
+        tryLsstExceptionWarn("Failed to translate C++ Exception to Python.");
+        return py::object();
+    }
+    if (e.getCause() && depth < MAX_CAUSES) {
+        // A missing cause should not prevent raising the exception itself.
+        py::object cause = translateCause(e.getCause(), depth + 1);
+        if (!cause.ptr() || PyObject_SetAttrString(instance.ptr(), "__cause__", cause.ptr()) != 0) {
+            PyErr_Clear();
         }
     }
+    return instance;
+}
+
+/**
+ * Create a Python exception for the cause of a C++ exception.
+ *
+ * LSST exceptions are translated as usual; other standard exceptions become a built-in
+ * RuntimeError with the same message.
+ *
+ * @param cause the C++ exception to translate
+ * @param depth how far down a chain of causes `cause` is
+ * @returns the Python exception, or a null object if it could not be created
+ */
+py::object translateCause(std::exception_ptr cause, int depth) {
+    try {
+        std::rethrow_exception(cause);
+    } catch (Exception const &e) {
+        return translateLsstException(e, depth);
+    } catch (std::exception const &e) {
+        return py::reinterpret_steal<py::object>(PyObject_CallFunction(PyExc_RuntimeError, "s", e.what()));
+    } catch (...) {
+        return py::reinterpret_steal<py::object>(
+                PyObject_CallFunction(PyExc_RuntimeError, "s", "unknown C++ exception"));
+    }
+}
+
+/**
+ * Raise a Python exception that wraps the given C++ exception instance.
+ *
+ * If any point we fail to translate the exception, we print a Python warning and raise the built-in
+ * Python RuntimeError exception with the same message as the C++ exception.
+ *
+ * @param e the C++ exception to raise
+ */
+void raiseLsstException(Exception const &e) {
+    py::object instance = translateLsstException(e);
+    if (instance.ptr()) {
+        auto type = py::reinterpret_borrow<py::object>(PyObject_Type(instance.ptr()));
+        PyErr_SetObject(type.ptr(), instance.ptr());
+    }
+}
+
+/**
+ * Wrap a Python callable as an exception observer.
+ *
+ * The observer may run on any thread, with or without the GIL held, so it acquires the GIL itself and
+ * leaves any Python error already being raised untouched.  Errors raised by the callable are reported
+ * as unraisable rather than propagated.
+ *
+ * @param callable a Python callable taking the translated exception, the Tracepoint and the event
+ * @returns an observer for addExceptionObserver
+ */
+ExceptionObserver makePythonObserver(py::function callable) {
+    // The observer may be copied and destroyed without the GIL, so only this shared_ptr may touch
+    // the callable's reference count.
+    std::shared_ptr<py::function> shared(new py::function(std::move(callable)), [](py::function *f) {
+        if (Py_IsInitialized()) {
+            py::gil_scoped_acquire gil;
+            delete f;
+        }  // else leak, as the interpreter is gone
+    });
+    return [shared](Exception const &e, Tracepoint const &tracepoint, ExceptionEvent event) {
+        if (!Py_IsInitialized()) return;
+        py::gil_scoped_acquire gil;
+        py::error_scope scope;
+        try {
+            // Construction is reported from the Exception constructor, before the derived class exists,
+            // so translate the exception as the type being constructed, if the site records it.
+            py::handle wrappedClass;
+            std::type_info const *type = tracepoint._site->_type;
+            if (event == ExceptionEvent::CONSTRUCTED && type && *type != typeid(e)) {
+                wrappedClass = py::detail::get_type_handle(*type, false);
+            }
+            py::object instance = translateLsstException(e, 0, wrappedClass);
+            if (!instance.ptr()) instance = py::none();
+            (*shared)(instance, tracepoint, event);
+        } catch (py::error_already_set &err) {
+            err.restore();
+            PyErr_WriteUnraisable(shared->ptr());
+        }
+    };
 }
 }  // namespace
 
@@ -91,26 +200,40 @@ PYBIND11_MODULE(exceptions, mod) {
     py::class_<Tracepoint> clsTracepoint(mod, "Tracepoint");
 
     clsTracepoint.def(py::init<char const *, int, char const *, std::string const &>())
-            .def_readwrite("_file", &Tracepoint::_file)
-            .def_readwrite("_line", &Tracepoint::_line)
-            .def_readwrite("_func", &Tracepoint::_func)
+            .def_property_readonly("_file", &Tracepoint::getFile)
+            .def_property_readonly("_line", &Tracepoint::getLine)
+            .def_property_readonly("_func", &Tracepoint::getFunction)
             .def_readwrite("_message", &Tracepoint::_message);
 
     py::class_<Exception> clsException(mod, "Exception");
 
     clsException.def(py::init<std::string const &>())
-            .def("addMessage", &Exception::addMessage)
+            .def("addMessage", py::overload_cast<char const *, int, char const *, std::string const &>(
+                                       &Exception::addMessage))
             .def("getTraceback", &Exception::getTraceback)
+            .def("getPath", &Exception::getPath)
+            .def("getErrno",
+                 [](Exception const &self) -> py::object {
+                     // Only codes in the POSIX categories have values that are errno values.
+                     std::error_code code = self.getErrorCode();
+                     if (!code || (code.category() != std::generic_category() &&
+                                   code.category() != std::system_category())) {
+                         return py::none();
+                     }
+                     return py::int_(code.value());
+                 })
+            .def("getErrorMessage",
+                 [](Exception const &self) -> std::string {
+                     std::error_code code = self.getErrorCode();
+                     return code ? code.message() : std::string();
+                 })
             .def("addToStream", &Exception::addToStream)
             .def("what", &Exception::what)
             .def("getType", &Exception::getType)
             .def("clone", &Exception::clone)
-            .def("asString",
-                 [](Exception &self) -> std::string {
-                     std::ostringstream stream;
-                     self.addToStream(stream);
-                     return stream.str();
-                 })
+            .def("memoryFootprint", &Exception::memoryFootprint)
+            .def("isLightweight", &Exception::isLightweight)
+            .def("asString", &Exception::asString)  // Python reports the cause itself, from __cause__
             .def("__repr__", [](Exception &self) -> std::string {
                 std::stringstream s;
                 s << "Exception('" << self.what() << "')";
@@ -128,6 +251,10 @@ PYBIND11_MODULE(exceptions, mod) {
 
     py::class_<IoError, RuntimeError> clsIoError(mod, "IoError");
     clsIoError.def(py::init<std::string const &>());
+    clsIoError.def(py::init([](std::string const &message, int errnum, std::string const &path) {
+                       return new IoError(message, std::error_code(errnum, std::generic_category()), path);
+                   }),
+                   "message"_a, "errno"_a, "path"_a = "");
 
     py::class_<OverflowError, RuntimeError> clsOverflowError(mod, "OverflowError");
     clsOverflowError.def(py::init<std::string const &>());
@@ -153,13 +280,60 @@ PYBIND11_MODULE(exceptions, mod) {
     py::class_<OutOfRangeError, LogicError> clsOutOfRangeError(mod, "OutOfRangeError");
     clsOutOfRangeError.def(py::init<std::string const &>());
 
+    py::class_<ExceptionRecord> clsExceptionRecord(mod, "ExceptionRecord");
+    clsExceptionRecord.def_readonly("timestamp", &ExceptionRecord::timestamp)
+            .def_readonly("type", &ExceptionRecord::type)
+            .def_readonly("file", &ExceptionRecord::file)
+            .def_readonly("line", &ExceptionRecord::line)
+            .def_readonly("function", &ExceptionRecord::function)
+            .def_readonly("message", &ExceptionRecord::message)
+            .def("__repr__", [](ExceptionRecord const &self) -> std::string {
+                std::stringstream s;
+                s << "ExceptionRecord(" << self.type << " at " << self.file << ":" << self.line << ": '"
+                  << self.message << "')";
+                return s.str();
+            });
+
+    mod.attr("FLIGHT_RECORDER_CAPACITY") = FLIGHT_RECORDER_CAPACITY;
+    mod.def("getRecentExceptions",
+            [](std::size_t n) -> py::list {
+                py::list result;
+                for (auto &record : getRecentExceptions(n)) result.append(py::cast(std::move(record)));
+                return result;
+            },
+            "n"_a = FLIGHT_RECORDER_CAPACITY);
+    mod.def("dumpRecentExceptions", &dumpRecentExceptions, "fd"_a, "n"_a = FLIGHT_RECORDER_CAPACITY);
+    mod.def("setFlightRecorderEnabled", &setFlightRecorderEnabled, "enabled"_a);
+    mod.def("isFlightRecorderEnabled", &isFlightRecorderEnabled);
+    mod.def("installFlightRecorderSignalHandlers", &installFlightRecorderSignalHandlers);
+
+    mod.def("getLiveExceptionCount", &getLiveExceptionCount);
+    mod.def("getLiveExceptionBytes", &getLiveExceptionBytes);
+    mod.def("hasExceptionGauges", &hasExceptionGauges);
+    mod.def("hasExceptionProbes", &hasExceptionProbes);
+
+    mod.def("installTerminateHandler", &installTerminateHandler);
+    mod.def("installTerminateSignalHandlers", &installTerminateSignalHandlers);
+
+    mod.def("loadSiteMap", &loadSiteMap, "path"_a);
+
+    py::enum_<ExceptionEvent>(mod, "ExceptionEvent")
+            .value("CONSTRUCTED", ExceptionEvent::CONSTRUCTED)
+            .value("MESSAGE_ADDED", ExceptionEvent::MESSAGE_ADDED);
+    mod.def("addExceptionObserver",
+            [](py::function callable) { return addExceptionObserver(makePythonObserver(callable)); },
+            "callable"_a);
+    mod.def("removeExceptionObserver", &removeExceptionObserver, "id"_a);
+
+    mod.def("setFaultRules", py::overload_cast<std::string const &>(&setFaultRules), "spec"_a);
+    mod.def("clearFaultRules", &clearFaultRules);
+    mod.def("getInjectedFaultCount", &getInjectedFaultCount);
+
     py::register_exception_translator([](std::exception_ptr p) {
         try {
             if (p) std::rethrow_exception(p);
         } catch (const Exception &e) {
-            py::object current_exception;
-            current_exception = py::cast(e.clone(), py::return_value_policy::take_ownership);
-            raiseLsstException(current_exception);
+            raiseLsstException(e);
         }
     });
 }
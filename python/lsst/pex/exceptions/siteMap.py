@@ -0,0 +1,205 @@
+#!/usr/bin/env python
+# This file is part of pex_exceptions.
+#
+# Developed for the LSST Data Management System.
+# This product includes software developed by the LSST Project
+# (https://www.lsst.org).
+# See the COPYRIGHT file at the top-level directory of this distribution
+# for details of code ownership.
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+"""Write the site map of a library or executable compiled with
+-DLSST_EXCEPT_SITE_IDS.
+
+In that mode each LSST_EXCEPT and LSST_EXCEPT_ADD site is known at run time
+only by an ID, and records its address, line and file in the non-allocated
+ELF section ``.lsst_except_sites``.  This script reads those records from a
+linked shared library or executable, names the function containing each site
+from the symbol table, and writes the map that lsst::pex::exceptions looks
+for next to the object (``<object>.sites``).  With ``--strip`` it then removes
+the section from the object.
+
+This is a standalone script, so that it can run before the package is built.
+"""
+
+__all__ = ["siteId", "readSites", "writeSiteMap", "main"]
+
+import argparse
+import bisect
+import os
+import re
+import shutil
+import struct
+import subprocess
+import sys
+
+SECTION = ".lsst_except_sites"
+
+
+def siteId(file, line):
+    """Return the ID of a site: the 64-bit FNV-1a hash computed by
+    TracepointSite::hashLocation.
+    """
+    mask = (1 << 64) - 1
+    prime = 1099511628211
+    value = 14695981039346656037
+    for byte in file.encode():
+        value = ((value ^ byte) * prime) & mask
+    return ((value ^ (line & 0xffffffff)) * prime) & mask
+
+
+def _readElf(data):
+    """Return the word size, byte order and sections (a dict of name to
+    (type, offset, size, link)) of an ELF object.
+    """
+    if data[:4] != b"\x7fELF":
+        raise ValueError("not an ELF object")
+    is64 = data[4] == 2
+    order = "<" if data[5] == 1 else ">"
+    if is64:
+        offset, = struct.unpack_from(order + "Q", data, 0x28)
+        entrySize, count, namesIndex = struct.unpack_from(order + "HHH", data, 0x3A)
+        layout = order + "IIQQQQIIQQ"
+    else:
+        offset, = struct.unpack_from(order + "I", data, 0x20)
+        entrySize, count, namesIndex = struct.unpack_from(order + "HHH", data, 0x2E)
+        layout = order + "IIIIIIIIII"
+    headers = [struct.unpack_from(layout, data, offset + i*entrySize) for i in range(count)]
+    namesOffset = headers[namesIndex][4]
+
+    def name(index):
+        end = data.index(b"\0", namesOffset + index)
+        return data[namesOffset + index:end].decode()
+
+    sections = {}
+    byIndex = []
+    for nameIndex, kind, flags, address, start, size, link, info, align, entry in headers:
+        byIndex.append((kind, start, size, link))
+        sections.setdefault(name(nameIndex), (kind, start, size, link))
+    return is64, order, sections, byIndex
+
+
+def _readFunctions(data, is64, order, sections, byIndex):
+    """Return the sorted (start, end, name) of the functions in the symbol
+    table, or the dynamic symbol table if the object has been stripped.
+    """
+    SYMTAB, DYNSYM, FUNC = 2, 11, 2
+    table = sections.get(".symtab") or sections.get(".dynsym")
+    if table is None or table[0] not in (SYMTAB, DYNSYM):
+        return []
+    kind, start, size, link = table
+    strings = byIndex[link][1]
+    layout = order + ("IBBHQQ" if is64 else "IIIBBH")
+    entrySize = struct.calcsize(layout)
+    functions = []
+    for offset in range(start, start + size, entrySize):
+        if is64:
+            nameIndex, info, other, section, value, length = struct.unpack_from(layout, data, offset)
+        else:
+            nameIndex, value, length, info, other, section = struct.unpack_from(layout, data, offset)
+        if info & 0xf != FUNC or value == 0:
+            continue
+        end = data.index(b"\0", strings + nameIndex)
+        functions.append((value, value + max(length, 1), data[strings + nameIndex:end].decode()))
+    functions.sort()
+    return functions
+
+
+def _demangle(names):
+    """Demangle C++ symbol names with c++filt, if it is available."""
+    filt = shutil.which("c++filt")
+    if not names or filt is None:
+        return names
+    result = subprocess.run([filt], input="\n".join(names) + "\n", stdout=subprocess.PIPE,
+                            universal_newlines=True, check=True)
+    demangled = result.stdout.split("\n")[:len(names)]
+    return demangled if len(demangled) == len(names) else names
+
+
+def readSites(path):
+    """Read the site records of a linked object.
+
+    Returns
+    -------
+    sites : `dict` [`int`, `tuple`]
+        The line, file and function of each site, by ID.  Where a site has
+        been inlined into several functions, the first (by address) is used.
+    """
+    with open(path, "rb") as stream:
+        data = stream.read()
+    is64, order, sections, byIndex = _readElf(data)
+    if SECTION not in sections:
+        return {}
+    kind, start, size, link = sections[SECTION]
+    addressFormat = order + ("Q" if is64 else "I")
+    addressSize = struct.calcsize(addressFormat)
+    records = []
+    offset = start
+    while True:
+        offset = start + (offset - start + 7) // 8 * 8
+        if offset + addressSize + 4 > start + size:
+            break
+        address, = struct.unpack_from(addressFormat, data, offset)
+        line, = struct.unpack_from(order + "I", data, offset + addressSize)
+        end = data.index(b"\0", offset + addressSize + 4)
+        file = data[offset + addressSize + 4:end].decode()
+        offset = end + 1
+        # Records for code the linker discarded have their address set to 0 (or all ones).
+        if address != 0 and address != (1 << (8*addressSize)) - 1:
+            records.append((address, line, file))
+    records.sort()
+
+    functions = _readFunctions(data, is64, order, sections, byIndex)
+    starts = [function[0] for function in functions]
+    sites = {}
+    for address, line, file in records:
+        i = bisect.bisect_right(starts, address) - 1
+        name = functions[i][2] if i >= 0 and address < functions[i][1] else "<unknown>"
+        sites.setdefault(siteId(file, line), (line, file, name))
+    names = sorted({site[2] for site in sites.values()})
+    # Drop the suffixes of compiler-generated copies, e.g. "f() [clone .cold]".
+    demangled = {name: re.sub(r"( \[clone [^]]*\])+$", "", pretty)
+                 for name, pretty in zip(names, _demangle(names))}
+    return {id: (line, file, demangled[name]) for id, (line, file, name) in sites.items()}
+
+
+def writeSiteMap(sites, path, comment=None):
+    """Write a site map in the format read by lsst::pex::exceptions."""
+    with open(path, "w") as stream:
+        if comment:
+            stream.write("# %s\n" % comment)
+        for id, (line, file, function) in sorted(sites.items()):
+            stream.write("%016x\t%d\t%s\t%s\n" % (id, line, file, function))
+
+
+def main(argv=None):
+    parser = argparse.ArgumentParser(description=__doc__.split("\n\n")[0])
+    parser.add_argument("object", help="linked shared library or executable")
+    parser.add_argument("-o", "--output", help="site map to write (default: <object>.sites)")
+    parser.add_argument("--strip", action="store_true",
+                        help="remove the site records from the object afterwards")
+    args = parser.parse_args(argv)
+    sites = readSites(args.object)
+    output = args.output or args.object + ".sites"
+    writeSiteMap(sites, output, comment="Site map for %s" % os.path.basename(args.object))
+    if args.strip:
+        objcopy = os.environ.get("OBJCOPY", "objcopy")
+        subprocess.run([objcopy, "--remove-section", SECTION, args.object], check=True)
+    print("%s: %d sites" % (output, len(sites)))
+
+
+if __name__ == "__main__":
+    sys.exit(main())
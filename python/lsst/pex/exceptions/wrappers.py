@@ -25,6 +25,9 @@ __all__ = ["register", "ExceptionMeta", "Exception", "LogicError",
            "UnderflowError", "NotFoundError", "IoError", "TypeError",
            "translate", "declare"]
 
+import functools
+import sys
+import types
 import warnings
 import builtins
 
@@ -32,6 +35,49 @@ from . import exceptions
 
 registry = {}
 
+_baseTraceback = builtins.BaseException.__traceback__
+
+
+class _SyntheticFrame(builtins.BaseException):
+    """Raised by the code objects that stand in for C++ tracepoints.
+    """
+    pass
+
+
+@functools.lru_cache(maxsize=256)
+def _tracepointCode(file, line, function):
+    """Return a code object that raises `_SyntheticFrame` from ``file``,
+    ``line`` and ``function``, for use as the frame of a C++ tracepoint.
+
+    Code objects are cached for the sites that fail repeatedly; the cache is
+    bounded because a long-running process may see any number of sites.
+    """
+    code = compile("\n" * (max(line, 1) - 1) + "raise _SyntheticFrame", file, "exec")
+    names = dict(co_name=function)
+    if hasattr(code, "co_qualname"):
+        names.update(co_qualname=function)
+    return code.replace(**names)
+
+
+def _makeTracebackFrames(tracepoints):
+    """Build a chain of synthetic traceback entries, outermost first, for a
+    C++ traceback (which lists the throw site first).
+
+    Each entry gets a real frame by executing a stub code object, so
+    debuggers and the `traceback` module see the C++ file, line and function
+    just as they would a Python frame.  No instruction offset is recorded, so
+    Python does not try to underline part of the C++ source line.
+    """
+    result = None
+    for tracepoint in tracepoints:
+        try:
+            exec(_tracepointCode(tracepoint._file, tracepoint._line, tracepoint._func),
+                 {"_SyntheticFrame": _SyntheticFrame})
+        except _SyntheticFrame as err:
+            frame = err.__traceback__.tb_next.tb_frame
+        result = types.TracebackType(result, frame, -1, tracepoint._line)
+    return result
+
 
 def register(cls):
     """A Python decorator that adds a Python exception wrapper to the registry that maps C++ Exceptions
@@ -70,6 +116,7 @@ class Exception(builtins.Exception, metaclass=ExceptionMeta):
             cpp = self.WrappedClass(message, *args, **kwds)
         super(Exception, self).__init__(message)
         self.cpp = cpp
+        self._cppFramesAdded = False
 
     def __getattr__(self, name):
         return getattr(self.cpp, name)
@@ -78,7 +125,59 @@ class Exception(builtins.Exception, metaclass=ExceptionMeta):
         return "%s('%s')" % (type(self).__name__, self.cpp.what())
 
     def __str__(self):
-        return self.cpp.asString()
+        # The traceback module shows the C++ tracepoints as frames once they
+        # have been added to __traceback__, so the line it prints for the
+        # exception leaves them out; every other caller gets the full text.
+        if self.__dict__.get("_cppFramesShown", False) \
+                and sys._getframe(1).f_globals.get("__name__") == "traceback":
+            return self.cpp.what()
+        # Logging and test frameworks may ask for this many times; keep the
+        # string until a message is added here.
+        text = self.__dict__.get("_str")
+        if text is None:
+            text = self._str = self.cpp.asString()
+        return text
+
+    def addMessage(self, *args):
+        """Add a message and tracepoint to the C++ exception (see
+        `lsst.pex.exceptions.exceptions.Exception.addMessage`).
+        """
+        self.__dict__.pop("_str", None)
+        self.cpp.addMessage(*args)
+
+    @property
+    def __traceback__(self):
+        """The Python traceback, continued by one frame per C++ tracepoint.
+
+        The C++ frames are only built the first time this is read, so
+        exceptions that are caught and discarded cost no more to raise.  They
+        are appended to the traceback object itself, so later readers of
+        `sys.exc_info` see them too.  From then on, the exception line printed
+        by the `traceback` module gives only the message, so that each C++
+        site is shown once there; `str` is otherwise unchanged.
+        """
+        traceback = _baseTraceback.__get__(self)
+        if not self.__dict__.get("_cppFramesAdded", True):
+            self._cppFramesAdded = True
+            try:
+                frames = _makeTracebackFrames(self.cpp.getTraceback())
+            except builtins.Exception:
+                frames = None  # the traceback is diagnostic only; never fail to provide it
+            if frames is not None:
+                if traceback is None:
+                    traceback = frames
+                    _baseTraceback.__set__(self, traceback)
+                else:
+                    last = traceback
+                    while last.tb_next is not None:
+                        last = last.tb_next
+                    last.tb_next = frames
+                self._cppFramesShown = True
+        return traceback
+
+    @__traceback__.setter
+    def __traceback__(self, traceback):
+        _baseTraceback.__set__(self, traceback)
 
 
 @register
@@ -133,17 +232,39 @@ class NotFoundError(Exception, builtins.LookupError):
 
 @register
 class IoError(RuntimeError, builtins.IOError):
+    """An LSST I/O error.
+
+    If the C++ exception carries an error number or path, they are available
+    as the standard `OSError` attributes ``errno``, ``strerror`` and
+    ``filename``.  When raised from Python, the error number and path may be
+    given after the message: ``IoError(message, errno, path)``.
+    """
+
     WrappedClass = exceptions.IoError
 
+    def __init__(self, arg, *args, **kwds):
+        super(IoError, self).__init__(arg, *args, **kwds)
+        errno = self.cpp.getErrno()
+        if errno is not None:
+            self.errno = errno
+            self.strerror = self.cpp.getErrorMessage()
+        path = self.cpp.getPath()
+        if path:
+            self.filename = path
+
 
 @register
 class TypeError(LogicError, builtins.TypeError):
     WrappedClass = exceptions.TypeError
 
 
-def translate(cpp):
-    """Translate a C++ Exception instance to Python and return it."""
-    PyType = registry.get(type(cpp), None)
+def translate(cpp, wrappedClass=None):
+    """Translate a C++ Exception instance to Python and return it.
+
+    The Python type is the one registered for ``wrappedClass``, if given,
+    or else for the type of ``cpp``.
+    """
+    PyType = registry.get(wrappedClass if wrappedClass is not None else type(cpp), None)
     if PyType is None:
         warnings.warn("Could not find appropriate Python type for C++ Exception")
         PyType = Exception
@@ -0,0 +1,53 @@
+/*
+ * This file is part of pex_exceptions.
+ *
+ * Developed for the LSST Data Management System.
+ * This product includes software developed by the LSST Project
+ * (https://www.lsst.org).
+ * See the COPYRIGHT file at the top-level directory of this distribution
+ * for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <string>
+
+#include "boost/format.hpp"
+
+#include "lsst/pex/exceptions/Context.h"
+
+namespace lsst {
+namespace pex {
+namespace exceptions {
+namespace detail {
+
+void addContext(Exception& exception, TracepointSite const* site, char const* format,
+                CheckValue const* values, std::size_t nValues) noexcept {
+    try {
+        std::string message;
+        try {
+            message = formatCheckMessage(format, values, nValues);
+        } catch (boost::io::format_error const&) {
+            message = format;  // the arguments do not match the format; better than nothing
+        }
+        exception.addMessage(site, message);
+    } catch (...) {
+        // Out of memory, or an observer failed; the exception is still worth propagating as it is.
+    }
+}
+
+}  // namespace detail
+}  // namespace exceptions
+}  // namespace pex
+}  // namespace lsst
@@ -0,0 +1,52 @@
+/*
+ * This file is part of pex_exceptions.
+ *
+ * Developed for the LSST Data Management System.
+ * This product includes software developed by the LSST Project
+ * (https://www.lsst.org).
+ * See the COPYRIGHT file at the top-level directory of this distribution
+ * for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <new>
+
+#include "lsst/pex/exceptions/Dispatch.h"
+
+namespace lsst {
+namespace pex {
+namespace exceptions {
+namespace detail {
+
+void DispatchTable::add(std::type_info const& type, int index) noexcept {
+    Entry const* entry = new (std::nothrow) Entry{&type, index};
+    if (!entry) return;  // the type will be resolved again next time
+    std::size_t const start = _slot(type);
+    for (std::size_t i = 0; i != SIZE; ++i) {
+        std::atomic<Entry const*>& slot = _entries[(start + i) % SIZE];
+        Entry const* current = nullptr;
+        if (slot.compare_exchange_strong(current, entry, std::memory_order_release,
+                                         std::memory_order_acquire)) {
+            return;
+        }
+        if (current->type == &type) break;  // added by another thread in the meantime
+    }
+    delete entry;  // already present, or the table is full
+}
+
+}  // namespace detail
+}  // namespace exceptions
+}  // namespace pex
+}  // namespace lsst
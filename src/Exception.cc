@@ -25,31 +25,565 @@
 #define __attribute__(x) /*NOTHING*/
 #endif
 
+#include <atomic>
 #include <cstring>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
 #include <ostream>
-#include <sstream>
 #include <string>
+#include <tuple>
 
 #include "lsst/pex/exceptions/Exception.h"
+#include "lsst/pex/exceptions/FlightRecorder.h"
+#include "lsst/pex/exceptions/Gauges.h"
+#include "lsst/pex/exceptions/Observer.h"
+#include "lsst/pex/exceptions/Probes.h"
 
 namespace lsst {
 namespace pex {
 namespace exceptions {
+namespace {
+
+#if defined(__GNUC__)
+// __thread needs no check for dynamic initialization on each access.
+#define LSST_EXCEPT_THREAD_LOCAL_ __thread
+#else
+#define LSST_EXCEPT_THREAD_LOCAL_ thread_local
+#endif
+
+#ifndef LSST_EXCEPT_NO_GAUGES
+std::atomic<std::size_t> liveExceptionCount(0);
+std::atomic<std::size_t> liveExceptionBytes(0);
+#endif
+
+#ifndef LSST_EXCEPT_NO_ARENA
+// Payloads and their strings are allocated from small per-thread caches of free blocks, so that a
+// thread that throws repeatedly reuses the same few blocks instead of going to the global allocator
+// each time.  Blocks are obtained from and returned to ::operator new and delete, and carry no record
+// of the thread that allocated them: a block freed on another thread (for example after the exception
+// was rethrown from a std::exception_ptr or handed to Python) simply joins that thread's cache, or is
+// returned to the global allocator if that cache is full or the thread is exiting.
+constexpr std::size_t ARENA_CLASSES = 5;  // blocks of 32, 64, 128, 256 and 512 bytes
+constexpr std::size_t ARENA_MIN_BLOCK = 32;
+constexpr std::size_t ARENA_MAX_BLOCK = ARENA_MIN_BLOCK << (ARENA_CLASSES - 1);
+constexpr unsigned ARENA_CACHE_BLOCKS = 32;  // the most free blocks kept per class and thread
+
+enum ArenaState { ARENA_UNUSED = 0, ARENA_ACTIVE, ARENA_CLOSED };
+
+struct FreeBlock {
+    FreeBlock* next;
+};
+
+// Constant-initialized, so that (unlike a thread_local with a destructor) access needs no guard.
+struct ArenaCache {
+    FreeBlock* heads[ARENA_CLASSES];
+    unsigned counts[ARENA_CLASSES];
+    ArenaState state;
+};
+
+LSST_EXCEPT_THREAD_LOCAL_ ArenaCache arenaCache;
+
+// Return a thread's cached blocks to the global allocator when it exits.
+struct ArenaReleaser {
+    ~ArenaReleaser() {
+        ArenaCache& cache = arenaCache;
+        for (std::size_t index = 0; index != ARENA_CLASSES; ++index) {
+            while (FreeBlock* block = cache.heads[index]) {
+                cache.heads[index] = block->next;
+                ::operator delete(block);
+            }
+            cache.counts[index] = 0;
+        }
+        cache.state = ARENA_CLOSED;  // blocks freed by later thread_local destructors bypass the cache
+    }
+};
+
+thread_local ArenaReleaser arenaReleaser;
+
+// Return the index of the smallest size class that holds the given number of bytes.
+inline std::size_t arenaClass(std::size_t size) noexcept {
+    std::size_t index = 0;
+    for (std::size_t block = ARENA_MIN_BLOCK; block < size; block <<= 1) ++index;
+    return index;
+}
+
+void* arenaAllocate(std::size_t size) {
+    if (size <= ARENA_MAX_BLOCK) {
+        ArenaCache& cache = arenaCache;
+        std::size_t const index = arenaClass(size);
+        if (FreeBlock* block = cache.heads[index]) {
+            cache.heads[index] = block->next;
+            --cache.counts[index];
+            return block;
+        }
+        size = ARENA_MIN_BLOCK << index;  // so that the block can be reused for anything in its class
+    }
+    return ::operator new(size);
+}
+
+void arenaDeallocate(void* pointer, std::size_t size) noexcept {
+    if (size <= ARENA_MAX_BLOCK) {
+        ArenaCache& cache = arenaCache;
+        std::size_t const index = arenaClass(size);
+        if (cache.state != ARENA_CLOSED && cache.counts[index] < ARENA_CACHE_BLOCKS) {
+            if (cache.state == ARENA_UNUSED) {
+                static_cast<void>(&arenaReleaser);  // first use on this thread registers the release
+                cache.state = ARENA_ACTIVE;
+            }
+            FreeBlock* block = static_cast<FreeBlock*>(pointer);
+            block->next = cache.heads[index];
+            cache.heads[index] = block;
+            ++cache.counts[index];
+            return;
+        }
+    }
+    ::operator delete(pointer);
+}
+
+// A standard allocator for the payload's own strings.
+template <typename T>
+struct ArenaAllocator {
+    typedef T value_type;
+
+    ArenaAllocator() noexcept = default;
+    template <typename U>
+    ArenaAllocator(ArenaAllocator<U> const&) noexcept {}
+
+    T* allocate(std::size_t n) { return static_cast<T*>(arenaAllocate(n * sizeof(T))); }
+    void deallocate(T* pointer, std::size_t n) noexcept { arenaDeallocate(pointer, n * sizeof(T)); }
+};
+
+template <typename T, typename U>
+bool operator==(ArenaAllocator<T> const&, ArenaAllocator<U> const&) noexcept {
+    return true;
+}
+
+template <typename T, typename U>
+bool operator!=(ArenaAllocator<T> const&, ArenaAllocator<U> const&) noexcept {
+    return false;
+}
+
+typedef std::basic_string<char, std::char_traits<char>, ArenaAllocator<char>> PayloadString;
+#else
+typedef std::string PayloadString;
+#endif
+
+// Return the number of bytes a string has allocated, excluding the string object itself.
+template <typename String>
+std::size_t heapBytes(String const& string) noexcept {
+    // Short strings are stored inside the object, and allocate nothing.
+    char const* object = reinterpret_cast<char const*>(&string);
+    std::less_equal<char const*> lessEqual;
+    if (lessEqual(object, string.data()) && !lessEqual(object + sizeof(string), string.data())) return 0;
+    return string.capacity() + 1;
+}
+
+// Append the lines that show one tracepoint of a traceback.
+void appendTracepoint(std::string& target, TracepointSite const& site, char const* message, std::size_t size,
+                      std::size_t index) {
+    target += "  File \"";
+    target += site.getFile();
+    target += "\", line ";
+    target += std::to_string(site._line);
+    target += ", in ";
+    target += site.getFunction();
+    target += "\n    ";
+    target.append(message, size);
+    target += " {";
+    target += std::to_string(index);
+    target += "}\n";
+}
+
+// Append the last line of a traceback: the type, without its trailing " *", and the text.
+void appendSummary(std::string& target, char const* type, char const* text, std::size_t size) {
+    target.append(type, std::strlen(type) - 2);
+    target += ": '";
+    target.append(text, size);
+    target += "'\n";
+}
+
+// Maximum number of causes added to a stream after an exception, in case of a cycle (an exception can
+// be given itself as its cause) or a chain too long to be useful.
+int const MAX_CAUSES = 16;
+
+// Number of causes being added to a stream by Exception::addToStream on this thread.
+LSST_EXCEPT_THREAD_LOCAL_ int causeDepth = 0;
+
+// Count one more cause being added to a stream for as long as it exists.
+struct CauseDepthGuard {
+    CauseDepthGuard() noexcept { ++causeDepth; }
+    ~CauseDepthGuard() noexcept { --causeDepth; }
+};
+
+// Fire the "created" probe (see Probes.h) for an exception created at a site, which may be null.
+// Its arguments are unused when the probes are compiled out.
+inline void probeCreated([[maybe_unused]] TracepointSite const* site,
+                         [[maybe_unused]] char const* message) noexcept {
+    LSST_EXCEPT_PROBE_(created, site && site->_type ? site->_type->name() : nullptr,
+                       site ? site->_file : nullptr, site ? site->_line : 0,
+                       site ? site->getCompiledFunction() : nullptr, message);
+}
+
+}  // namespace
+
+std::size_t getLiveExceptionCount() noexcept {
+#ifndef LSST_EXCEPT_NO_GAUGES
+    return liveExceptionCount.load(std::memory_order_relaxed);
+#else
+    return 0;
+#endif
+}
+
+std::size_t getLiveExceptionBytes() noexcept {
+#ifndef LSST_EXCEPT_NO_GAUGES
+    return liveExceptionBytes.load(std::memory_order_relaxed);
+#else
+    return 0;
+#endif
+}
+
+bool hasExceptionGauges() noexcept {
+#ifndef LSST_EXCEPT_NO_GAUGES
+    return true;
+#else
+    return false;
+#endif
+}
+
+bool hasExceptionProbes() noexcept {
+#ifdef LSST_EXCEPT_HAS_PROBES_
+    return true;
+#else
+    return false;
+#endif
+}
+
+TracepointSite const* TracepointSite::intern(char const* file, int line, char const* func,
+                                             std::type_info const* type) {
+    // Keys own copies of the strings, and std::map never moves its nodes, so the stored sites can
+    // point into their own keys.
+    typedef std::tuple<std::string, int, std::string, std::type_info const*> Key;
+    static std::mutex mutex;
+    static std::map<Key, TracepointSite> sites;
+    std::lock_guard<std::mutex> lock(mutex);
+    Key key(file ? file : "", line, func ? func : "", type);
+    auto iter = sites.find(key);
+    if (iter == sites.end()) {
+        iter = sites.emplace(key, TracepointSite(nullptr, line, nullptr, type)).first;
+        iter->second = TracepointSite(std::get<0>(iter->first).c_str(), line,
+                                      std::get<2>(iter->first).c_str(), type);
+    }
+    return &iter->second;
+}
+
+Tracepoint::Tracepoint(TracepointSite const* site, std::string const& message)
+        : _site(site), _message(message) {}
 
 Tracepoint::Tracepoint(char const* file, int line, char const* func, std::string const& message)
-        : _file(file), _line(line), _func(func), _message(message) {}
+        : Tracepoint(TracepointSite::intern(file, line, func), message) {}
+
+/**
+ * The message and traceback of an Exception, shared between copies until one of them is modified.
+ *
+ * If the exception has an error code or path, the description of those is not appended to
+ * `message` and the first tracepoint's message until it is needed: const accessors format it once
+ * into `text`, and modifying the payload appends it in place.
+ */
+struct Exception::Payload {
+    // The traceback starts with a tracepoint at the given site, or is empty if the site is null.
+    Payload(std::string const& message_, TracepointSite const* site, std::error_code const& errorCode_ = {},
+            std::string const& path_ = {})
+            : message(message_.data(), message_.size()),
+              errorCode(errorCode_),
+              path(path_),
+              deferred(errorCode_ || !path_.empty()),
+              representation(nullptr),
+              textBytes(0),
+              accountedBytes(0),
+              references(1) {
+        if (site) traceback.emplace_back(site, message_);  // built in place, rather than copied
+#ifndef LSST_EXCEPT_NO_GAUGES
+        liveExceptionCount.fetch_add(1, std::memory_order_relaxed);
+#endif
+        account();
+    }
+
+#ifndef LSST_EXCEPT_NO_ARENA
+    static void* operator new(std::size_t size) { return arenaAllocate(size); }
+    static void operator delete(void* pointer, std::size_t size) noexcept { arenaDeallocate(pointer, size); }
+#endif
+
+    // Copies get their own once_flag, so the formatted text is not copied.
+    Payload(Payload const& other)
+            : message(other.message),
+              traceback(other.traceback),
+              errorCode(other.errorCode),
+              path(other.path),
+              cause(other.cause),
+              deferred(other.deferred),
+              representation(nullptr),
+              textBytes(0),
+              accountedBytes(0),
+              references(1) {
+#ifndef LSST_EXCEPT_NO_GAUGES
+        liveExceptionCount.fetch_add(1, std::memory_order_relaxed);
+#endif
+        account();
+    }
+
+    ~Payload() noexcept {
+        delete representation.load(std::memory_order_relaxed);
+#ifndef LSST_EXCEPT_NO_GAUGES
+        liveExceptionCount.fetch_sub(1, std::memory_order_relaxed);
+        liveExceptionBytes.fetch_sub(accountedBytes + textBytes.load(std::memory_order_relaxed),
+                                     std::memory_order_relaxed);
+#endif
+    }
+
+    // Return the number of bytes used by the payload, excluding the formatted text.
+    std::size_t computeBytes() const noexcept {
+        std::size_t result = sizeof(Payload) + heapBytes(message) + heapBytes(path);
+        result += traceback.capacity() * sizeof(Tracepoint);
+        for (Tracepoint const& tracepoint : traceback) result += heapBytes(tracepoint._message);
+        return result;
+    }
+
+    // Update the live bytes gauge after the payload has been created or modified.
+    void account() noexcept {
+#ifndef LSST_EXCEPT_NO_GAUGES
+        std::size_t bytes = computeBytes();
+        liveExceptionBytes.fetch_add(bytes - accountedBytes, std::memory_order_relaxed);  // may wrap
+        accountedBytes = bytes;
+#endif
+    }
+
+    // Append the description of the error code and path to a message.
+    template <typename String>
+    void appendDetail(String& target) const {
+        if (errorCode) {
+            if (!target.empty()) target += ": ";
+            target += errorCode.message().c_str();
+        }
+        if (!path.empty()) {
+            if (!target.empty()) target += ": ";
+            target += "'";
+            target.append(path.data(), path.size());
+            target += "'";
+        }
+    }
+
+    // Return the full message, formatting it on first use if necessary.
+    PayloadString const& getText() const noexcept {
+        if (!deferred) return message;
+        try {
+            std::call_once(textFlag, [this]() {
+                PayloadString result = message;
+                appendDetail(result);
+                text.swap(result);
+                // Recorded separately, as the text may be formatted while the payload is shared.
+                std::size_t bytes = heapBytes(text);
+                textBytes.fetch_add(bytes, std::memory_order_relaxed);
+#ifndef LSST_EXCEPT_NO_GAUGES
+                liveExceptionBytes.fetch_add(bytes, std::memory_order_relaxed);
+#endif
+            });
+            return text;
+        } catch (...) {
+            return message;  // out of memory; an undecorated message is better than nothing
+        }
+    }
+
+    // Return the message of a tracepoint, including the deferred description for the first.
+    std::string getTracepointMessage(std::size_t i) const {
+        std::string result = traceback[i]._message;
+        if (deferred && i == 0) appendDetail(result);
+        return result;
+    }
+
+    // Return the text added to a stream by addTracebackToStream, for an exception of the given type.
+    std::string formatRepresentation(char const* type) const {
+        PayloadString const& summary = getText();
+        if (traceback.empty()) {
+            // The exception was raised in Python, so we don't include the traceback, the type, or any
+            // newlines, because Python will print those itself.
+            return std::string(summary.data(), summary.size());
+        }
+        std::string result = "\n";  // Separates our text from the "<type>: " prefix added by Python.
+        for (std::size_t i = 0; i != traceback.size(); ++i) {
+            std::string const message = getTracepointMessage(i);
+            appendTracepoint(result, *traceback[i]._site, message.data(), message.size(), i);
+        }
+        appendSummary(result, type, summary.data(), summary.size());
+        return result;
+    }
+
+    // Return the cached representation for an exception of the given type, formatting it on first use,
+    // or null if the cache holds that of another type (a sliced copy sharing this payload).
+    std::string const* getRepresentation(char const* type) const {
+        Representation* cached = representation.load(std::memory_order_acquire);
+        if (!cached) {
+            std::unique_ptr<Representation> made(new Representation{type, formatRepresentation(type)});
+            if (representation.compare_exchange_strong(cached, made.get(), std::memory_order_acq_rel,
+                                                       std::memory_order_acquire)) {
+                cached = made.release();
+                std::size_t bytes = sizeof(Representation) + heapBytes(cached->text);
+                textBytes.fetch_add(bytes, std::memory_order_relaxed);
+#ifndef LSST_EXCEPT_NO_GAUGES
+                liveExceptionBytes.fetch_add(bytes, std::memory_order_relaxed);
+#endif
+            }  // else another thread got there first, and cached now points to its result
+        }
+        return cached->type == type ? &cached->text : nullptr;
+    }
+
+    // Discard the cached representation; the payload must not be shared.
+    void forgetRepresentation() noexcept {
+        Representation* cached = representation.exchange(nullptr, std::memory_order_relaxed);
+        if (!cached) return;
+        std::size_t bytes = sizeof(Representation) + heapBytes(cached->text);
+        textBytes.fetch_sub(bytes, std::memory_order_relaxed);
+#ifndef LSST_EXCEPT_NO_GAUGES
+        liveExceptionBytes.fetch_sub(bytes, std::memory_order_relaxed);
+#endif
+        delete cached;
+    }
+
+    // Append the deferred description in place; the payload must not be shared.
+    void undefer() {
+        if (!deferred) return;
+        PayloadString newMessage = message;
+        appendDetail(newMessage);
+        if (!traceback.empty()) appendDetail(traceback.front()._message);
+        message.swap(newMessage);
+        deferred = false;
+    }
+
+    PayloadString message;
+    Traceback traceback;
+    std::error_code errorCode;
+    std::string path;
+    std::exception_ptr cause;
+    bool deferred;  // whether message and traceback lack the error code and path
+    mutable std::once_flag textFlag;
+    mutable PayloadString text;  // valid once textFlag is set
+    struct Representation {
+        char const* type;  // getType() of the exception it was formatted for
+        std::string text;
+    };
+    mutable std::atomic<Representation*> representation;  // null until formatted, or once modified
+    mutable std::atomic<std::size_t> textBytes;  // bytes of text and representation, for the gauges
+    std::size_t accountedBytes;                  // computeBytes() as last added to the gauge
+    // Drop one reference, deleting the payload if it was the last.
+    void release() noexcept {
+        // Release our writes to the payload before another exception deletes or modifies it.
+        if (references.fetch_sub(1, std::memory_order_release) == 1) {
+            std::atomic_thread_fence(std::memory_order_acquire);
+            delete this;
+        }
+    }
+
+    std::atomic<long> references;  // number of exceptions sharing this payload
+};
+
+Exception::Exception(TracepointSite const* site, std::string const& message)
+        : _payload(new Payload(message, site)),
+          _lightSite(nullptr),
+          _lightMessage(nullptr) {
+    probeCreated(site, message.c_str());
+    detail::recordException(site, message);
+    if (detail::observersActive.load(std::memory_order_relaxed)) {
+        detail::notifyObservers(*this, _payload->traceback.front(), ExceptionEvent::CONSTRUCTED);
+    }
+}
+
+Exception::Exception(TracepointSite const* site, std::string const& message,
+                     std::error_code const& errorCode, std::string const& path)
+        : _payload(new Payload(message, site, errorCode, path)),
+          _lightSite(nullptr),
+          _lightMessage(nullptr) {
+    probeCreated(site, message.c_str());
+    detail::recordException(site, message);
+    if (detail::observersActive.load(std::memory_order_relaxed)) {
+        detail::notifyObservers(*this, _payload->traceback.front(), ExceptionEvent::CONSTRUCTED);
+    }
+}
+
+Exception::Exception(std::string const& message, std::error_code const& errorCode, std::string const& path)
+        : _payload(new Payload(message, nullptr, errorCode, path)),
+          _lightSite(nullptr),
+          _lightMessage(nullptr) {
+    probeCreated(nullptr, message.c_str());
+    detail::recordException(nullptr, message);
+}
 
 Exception::Exception(char const* file, int line, char const* func, std::string const& message)
-        : _message(message), _traceback(1, Tracepoint(file, line, func, message)) {}
+        : Exception(TracepointSite::intern(file, line, func), message) {}
+
+Exception::Exception(std::string const& message)
+        : _payload(new Payload(message, nullptr)), _lightSite(nullptr), _lightMessage(nullptr) {
+    probeCreated(nullptr, message.c_str());
+    detail::recordException(nullptr, message);
+}
+
+Exception::Exception(TracepointSite const* site, StaticMessage message) noexcept
+        : _payload(nullptr), _lightSite(site), _lightMessage(message._text) {
+    probeCreated(site, message._text);
+}
 
-Exception::Exception(std::string const& message) : _message(message), _traceback() {}
+Exception::Exception(Exception const& other) noexcept
+        : std::exception(other),
+          _payload(other._payload),
+          _lightSite(other._lightSite),
+          _lightMessage(other._lightMessage) {
+    if (_payload) _payload->references.fetch_add(1, std::memory_order_relaxed);
+}
 
-Exception::~Exception(void) noexcept {}
+Exception& Exception::operator=(Exception const& other) noexcept {
+    if (other._payload) other._payload->references.fetch_add(1, std::memory_order_relaxed);
+    if (_payload) _payload->release();
+    _payload = other._payload;
+    _lightSite = other._lightSite;
+    _lightMessage = other._lightMessage;
+    return *this;
+}
+
+Exception::~Exception(void) noexcept {
+    if (_payload) _payload->release();
+}
 
 void Exception::addMessage(char const* file, int line, char const* func, std::string const& message) {
-    std::ostringstream stream;
-    stream << _message;
-    if (_traceback.empty()) {
+    addMessage(TracepointSite::intern(file, line, func), message);
+}
+
+Exception::Payload& Exception::_mutablePayload() {
+    if (!_payload) {
+        // Upgrade a lightweight exception to a full one, as if it had been created by LSST_EXCEPT.
+        _payload = new Payload(_lightMessage, _lightSite);
+        _lightSite = nullptr;
+        _lightMessage = nullptr;
+    } else if (_payload->references.load(std::memory_order_relaxed) > 1) {
+        Payload* copy = new Payload(*_payload);
+        _payload->release();
+        _payload = copy;
+    } else {
+        // Order our writes after the reads made by any copy that has just released the payload.
+        std::atomic_thread_fence(std::memory_order_acquire);
+        _payload->forgetRepresentation();
+    }
+    return *_payload;
+}
+
+void Exception::addMessage(TracepointSite const* site, std::string const& message) {
+    // Build the new message with plain string appends: constructing a std::ostringstream takes a
+    // process-wide lock on the global locale, which serializes threads that throw concurrently.
+    LSST_EXCEPT_PROBE_(message_added, typeid(*this).name(), site ? site->_file : nullptr,
+                       site ? site->_line : 0, site ? site->getCompiledFunction() : nullptr, message.c_str());
+    Payload& payload = _mutablePayload();
+    payload.undefer();
+    PayloadString text = payload.message;
+    if (payload.traceback.empty()) {
         // This means the message-only constructor was used, which should only happen
         // from Python...but this method isn't accessible from Python, so maybe
         // this Exception was thrown in Python, then passed back to C++.  Or, more
@@ -60,43 +594,106 @@ void Exception::addMessage(char const* file, int line, char const* func, std::st
         // this is a rare case (and should be considered a bug, but we don't want
         // exception code throwing its own exceptions unless it absolutely has to),
         // we'll proceed by just appending the message and ignoring the traceback.
-        stream << "; " << message;
+        text += "; ";
+        text.append(message.data(), message.size());
     } else {
-        if (_traceback.size() == static_cast<std::size_t>(1)) {
+        if (payload.traceback.size() == static_cast<std::size_t>(1)) {
             // The original message doesn't have an index (because it's faster,
             // and there's no need if there's only one), so when we add the second,
             // we have to give it an index.
-            stream << " {0}; ";
+            text += " {0}; ";
+        } else {
+            text += "; ";
+        }
+        text.append(message.data(), message.size());
+        text += " {";
+        text += std::to_string(payload.traceback.size()).c_str();
+        text += "}";
+        payload.traceback.push_back(Tracepoint(site, message));
+    }
+    payload.message.swap(text);
+    payload.account();
+    if (detail::observersActive.load(std::memory_order_relaxed)) {
+        if (payload.traceback.empty()) {
+            detail::notifyObservers(*this, Tracepoint(site, message), ExceptionEvent::MESSAGE_ADDED);
         } else {
-            stream << "; ";
+            detail::notifyObservers(*this, payload.traceback.back(), ExceptionEvent::MESSAGE_ADDED);
         }
-        stream << message << " {" << _traceback.size() << "}";
-        _traceback.push_back(Tracepoint(file, line, func, message));
     }
-    _message = stream.str();
 }
 
-Traceback const& Exception::getTraceback(void) const noexcept { return _traceback; }
+Traceback const& Exception::getTraceback(void) const noexcept {
+    static Traceback const empty;
+    return _payload ? _payload->traceback : empty;
+}
+
+std::error_code Exception::getErrorCode(void) const noexcept {
+    return _payload ? _payload->errorCode : std::error_code();
+}
+
+std::string const& Exception::getPath(void) const noexcept {
+    static std::string const empty;
+    return _payload ? _payload->path : empty;
+}
+
+void Exception::setCause(std::exception_ptr cause) { _mutablePayload().cause = std::move(cause); }
+
+std::exception_ptr Exception::getCause(void) const noexcept {
+    return _payload ? _payload->cause : std::exception_ptr();
+}
+
+std::size_t Exception::memoryFootprint(void) const noexcept {
+    if (!_payload) return sizeof(Exception);  // the message is static
+    return sizeof(Exception) + _payload->computeBytes() + _payload->textBytes.load(std::memory_order_relaxed);
+}
 
 std::ostream& Exception::addToStream(std::ostream& stream) const {
-    if (_traceback.empty()) {
-        // The exception was raised in Python, so we don't include the traceback, the type, or any
-        // newlines, because Python will print those itself.
-        stream << _message;
-    } else {
-        stream << std::endl;  // Start with a newline to separate our stuff from Pythons "<type>: " prefix.
-        for (std::size_t i = 0; i != _traceback.size(); ++i) {
-            stream << "  File \"" << _traceback[i]._file << "\", line " << _traceback[i]._line << ", in "
-                   << _traceback[i]._func << std::endl;
-            stream << "    " << _traceback[i]._message << " {" << i << "}" << std::endl;
+    addTracebackToStream(stream);
+    if (_payload && _payload->cause) {
+        // Rethrowing is the only portable way to inspect an exception_ptr; that is acceptable
+        // here since we are already formatting text for a person to read.
+        if (_payload->traceback.empty()) stream << std::endl;
+        stream << "Caused by:";
+        if (causeDepth >= MAX_CAUSES) return stream << " ... (further causes not shown)" << std::endl;
+        CauseDepthGuard guard;
+        try {
+            std::rethrow_exception(_payload->cause);
+        } catch (Exception const& cause) {
+            if (cause.getTraceback().empty()) stream << " ";
+            cause.addToStream(stream);
+        } catch (std::exception const& cause) {
+            stream << " " << cause.what() << std::endl;
+        } catch (...) {
+            stream << " unknown exception" << std::endl;
         }
-        std::string type(getType(), 0, std::strlen(getType()) - 2);
-        stream << type << ": '" << _message << "'" << std::endl;
     }
     return stream;
 }
 
-char const* Exception::what(void) const noexcept { return _message.c_str(); }
+std::ostream& Exception::addTracebackToStream(std::ostream& stream) const {
+    if (_payload) {
+        if (std::string const* cached = _payload->getRepresentation(getType())) return stream << *cached;
+    }
+    return stream << asString();
+}
+
+std::string Exception::asString(void) const {
+    if (!_payload) {
+        // A lightweight exception is shown like a full one with a single tracepoint.
+        std::string result = "\n";
+        std::size_t const size = std::strlen(_lightMessage);
+        appendTracepoint(result, *_lightSite, _lightMessage, size, 0);
+        appendSummary(result, getType(), _lightMessage, size);
+        return result;
+    }
+    char const* type = getType();
+    if (std::string const* cached = _payload->getRepresentation(type)) return *cached;
+    return _payload->formatRepresentation(type);
+}
+
+char const* Exception::what(void) const noexcept {
+    return _payload ? _payload->getText().c_str() : _lightMessage;
+}
 
 char const* Exception::getType(void) const noexcept { return "lsst::pex::exceptions::Exception *"; }
 
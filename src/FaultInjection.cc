@@ -0,0 +1,318 @@
+/*
+ * This file is part of pex_exceptions.
+ *
+ * Developed for the LSST Data Management System.
+ * This product includes software developed by the LSST Project
+ * (https://www.lsst.org).
+ * See the COPYRIGHT file at the top-level directory of this distribution
+ * for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+#include "lsst/pex/exceptions/Exception.h"
+#include "lsst/pex/exceptions/FaultInjection.h"
+#include "lsst/pex/exceptions/Runtime.h"
+
+namespace lsst {
+namespace pex {
+namespace exceptions {
+namespace {
+
+/*
+ * A rule as used for matching: the type is stored in its mangled (Itanium ABI) form, so that sites
+ * can be matched against type_info::name() without demangling, and each rule keeps its own count of
+ * considered calls.
+ */
+struct ActiveRule {
+    explicit ActiveRule(FaultRule const& rule);
+
+    bool matches(TracepointSite const* site) const noexcept;
+    bool matchesUncached(TracepointSite const* site) const noexcept;
+    bool fire() noexcept;
+
+    FaultRule rule;
+    std::string mangledType;  // exact match; empty if unset
+    std::string mangledTail;  // suffix match for unqualified names; empty if unset
+    std::uint64_t threshold;  // fire if a draw is below this; probability >= 1 fires always
+    bool always;
+    std::atomic<std::uint64_t> calls;
+    std::atomic<std::uint64_t> considered;
+    // The last sites found to match and not to match, to skip string comparisons in loops.
+    mutable std::atomic<TracepointSite const*> lastMatch;
+    mutable std::atomic<TracepointSite const*> lastMismatch;
+};
+typedef std::vector<std::unique_ptr<ActiveRule>> RuleList;
+
+std::string mangleComponent(std::string const& name) { return std::to_string(name.size()) + name; }
+
+ActiveRule::ActiveRule(FaultRule const& rule_)
+        : rule(rule_), threshold(0), always(rule_.probability >= 1.0),
+          calls(0),
+          considered(0),
+          lastMatch(nullptr),
+          lastMismatch(nullptr) {
+    if (!rule.type.empty()) {
+        std::string type = rule.type;
+        if (type.compare(0, 2, "::") == 0) type.erase(0, 2);
+        std::size_t const colons = type.find("::");
+        if (colons == std::string::npos) {
+            mangledType = mangleComponent(type);
+            mangledTail = mangleComponent(type) + "E";
+        } else {
+            mangledType = "N";
+            for (std::size_t start = 0; start != std::string::npos;) {
+                std::size_t const end = type.find("::", start);
+                mangledType += mangleComponent(type.substr(start, end - start));
+                start = (end == std::string::npos) ? end : end + 2;
+            }
+            mangledType += "E";
+        }
+    }
+    if (!always && rule.probability > 0.0) {
+        threshold = static_cast<std::uint64_t>(rule.probability * 18446744073709551616.0);
+    }
+}
+
+bool endsWith(char const* text, std::string const& suffix) noexcept {
+    std::size_t const length = std::strlen(text);
+    return length >= suffix.size() && suffix.compare(text + length - suffix.size()) == 0;
+}
+
+bool ActiveRule::matches(TracepointSite const* site) const noexcept {
+    if (site == lastMatch.load(std::memory_order_relaxed)) return true;
+    if (site == lastMismatch.load(std::memory_order_relaxed)) return false;
+    bool const result = matchesUncached(site);
+    (result ? lastMatch : lastMismatch).store(site, std::memory_order_relaxed);
+    return result;
+}
+
+bool ActiveRule::matchesUncached(TracepointSite const* site) const noexcept {
+    if (rule.line != 0 && site->_line != rule.line) return false;
+    if (rule.fingerprint != 0 && site->_hash != rule.fingerprint) return false;
+    if (!rule.file.empty()) {
+        // Match whole path components, so "Fit.cc" does not select "BadFit.cc".
+        // A site compiled with LSST_EXCEPT_SITE_IDS whose site map is not loaded (see SiteMap.h) has no
+        // path, only a placeholder that no path ends with; it can be selected by fingerprint.
+        char const* file = site->getFile();
+        std::size_t const length = std::strlen(file);
+        if (!endsWith(file, rule.file)) return false;
+        if (length > rule.file.size() && file[length - rule.file.size() - 1] != '/') return false;
+    }
+    if (!mangledType.empty()) {
+        if (!site->_type) return false;
+        char const* name = site->_type->name();
+        if (*name == '*') ++name;  // marks types with internal linkage on some platforms
+        if (mangledType != name && (mangledTail.empty() || !endsWith(name, mangledTail))) return false;
+    }
+    return true;
+}
+
+// SplitMix64 finalizer; a good 64-bit mix for counter-based random numbers.
+std::uint64_t mix(std::uint64_t z) noexcept {
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+}
+
+bool ActiveRule::fire() noexcept {
+    if (rule.every > 1) {
+        std::uint64_t const call = calls.fetch_add(1, std::memory_order_relaxed) + 1;
+        if (call % rule.every != 0) return false;
+    }
+    if (always) return true;
+    // The k-th considered call draws the k-th number of the seeded sequence, whichever thread makes it.
+    std::uint64_t const k = considered.fetch_add(1, std::memory_order_relaxed) + 1;
+    return mix(rule.seed + k * 0x9e3779b97f4a7c15ULL) < threshold;
+}
+
+/*
+ * Throw InvalidParameterError if `rule` could never match a site, so that a mistake is reported once,
+ * when the rules are set, rather than silently injecting nothing.
+ */
+void checkRule(FaultRule const& rule) {
+    // Types are matched by their mangled names, which are only built for plain (qualified) class names.
+    std::string const& type = rule.type;
+    for (std::size_t i = 0; i < type.size(); ++i) {
+        char const c = type[i];
+        if (std::isalnum(static_cast<unsigned char>(c)) || c == '_') continue;
+        if (c == ':' && i + 1 < type.size() && type[i + 1] == ':') {
+            ++i;
+            continue;
+        }
+        throw LSST_EXCEPT(InvalidParameterError,
+                          "Fault rule type '" + type + "' is not a class name and cannot match any site");
+    }
+    if (rule.file.compare(0, 6, "<site ") == 0) {
+        throw LSST_EXCEPT(InvalidParameterError, "Fault rule file '" + rule.file +
+                                                         "' is a site ID and cannot match any site; "
+                                                         "select the site by fingerprint instead");
+    }
+}
+
+/*
+ * The rules are replaced as a whole under rulesMutex and published through an atomic pointer, so they
+ * can be changed while other threads are checking.  Checking threads count themselves in activeCheckers
+ * while they use a list; a replaced list is freed once a later installRules sees no checking threads,
+ * which (both sides being sequentially consistent) means none can still be reading it.  Until then it
+ * is kept, so at most the lists replaced while some thread was checking are outstanding.
+ */
+std::mutex rulesMutex;
+std::atomic<RuleList const*> activeRules(nullptr);
+std::atomic<int> activeCheckers(0);
+std::atomic<std::uint64_t> injectedCount(0);
+
+void installRules(std::vector<FaultRule> const& rules) {
+    // Guarded by rulesMutex; never destroyed, as checks may run during static destruction.
+    static auto* retiredLists = new std::vector<std::unique_ptr<RuleList const>>();
+    std::unique_ptr<RuleList> list(new RuleList());
+    for (FaultRule const& rule : rules) {
+        checkRule(rule);
+        list->emplace_back(new ActiveRule(rule));
+    }
+    std::lock_guard<std::mutex> lock(rulesMutex);
+    bool const enabled = !list->empty();
+    retiredLists->emplace_back(activeRules.exchange(list.release()));
+    injectedCount.store(0, std::memory_order_relaxed);
+    detail::faultInjectionEnabled.store(enabled, std::memory_order_relaxed);
+    if (activeCheckers.load() == 0) retiredLists->clear();
+}
+
+std::uint64_t parseNumber(std::string const& key, std::string const& value) {
+    try {
+        std::size_t end = 0;
+        std::uint64_t result = std::stoull(value, &end, 0);
+        if (end == value.size()) return result;
+    } catch (std::exception const&) {
+    }
+    throw LSST_EXCEPT(InvalidParameterError,
+                      "Invalid value for fault rule field " + key + ": '" + value + "'");
+}
+
+FaultRule parseRule(std::string const& spec) {
+    FaultRule rule;
+    for (std::size_t start = 0; start <= spec.size();) {
+        std::size_t end = spec.find(',', start);
+        if (end == std::string::npos) end = spec.size();
+        std::string const field = spec.substr(start, end - start);
+        start = end + 1;
+        if (field.empty()) continue;
+        std::size_t const equals = field.find('=');
+        if (equals == std::string::npos) {
+            throw LSST_EXCEPT(InvalidParameterError, "Fault rule field '" + field + "' is not key=value");
+        }
+        std::string const key = field.substr(0, equals);
+        std::string const value = field.substr(equals + 1);
+        if (key == "site" && value.compare(0, 6, "<site ") == 0 && value.back() == '>') {
+            // The placeholder shown for a site whose site map is not loaded; its ID is its fingerprint.
+            rule.fingerprint = parseNumber(key, value.substr(6, value.size() - 7));
+        } else if (key == "site") {
+            std::size_t const colon = value.rfind(':');
+            if (colon != std::string::npos) {
+                rule.file = value.substr(0, colon);
+                rule.line = static_cast<int>(parseNumber(key, value.substr(colon + 1)));
+            } else {
+                rule.file = value;
+            }
+        } else if (key == "fingerprint") {
+            rule.fingerprint = parseNumber(key, value);
+        } else if (key == "type") {
+            rule.type = value;
+        } else if (key == "every") {
+            rule.every = parseNumber(key, value);
+        } else if (key == "seed") {
+            rule.seed = parseNumber(key, value);
+        } else if (key == "probability") {
+            char* endPtr = nullptr;
+            rule.probability = std::strtod(value.c_str(), &endPtr);
+            if (value.empty() || *endPtr != '\0' || !(rule.probability >= 0.0)) {
+                throw LSST_EXCEPT(InvalidParameterError, "Invalid fault rule probability: '" + value + "'");
+            }
+        } else {
+            throw LSST_EXCEPT(InvalidParameterError, "Unknown fault rule field '" + key + "'");
+        }
+    }
+    checkRule(rule);
+    return rule;
+}
+
+// Read LSST_EXCEPT_FAULTS when the library is loaded.
+struct EnvironmentRules {
+    EnvironmentRules() {
+        char const* spec = std::getenv("LSST_EXCEPT_FAULTS");
+        if (!spec || !*spec) return;
+        try {
+            installRules(parseFaultRules(spec));
+        } catch (Exception const& e) {
+            std::cerr << "Ignoring LSST_EXCEPT_FAULTS: " << e.what() << std::endl;
+        }
+    }
+} environmentRules;
+
+}  // namespace
+
+namespace detail {
+
+std::atomic<bool> faultInjectionEnabled(false);
+
+bool shouldInjectFault(TracepointSite const* site) noexcept {
+    activeCheckers.fetch_add(1);
+    RuleList const* rules = activeRules.load();
+    bool inject = false;
+    if (rules) {
+        for (auto const& rule : *rules) {
+            if (rule->matches(site) && rule->fire()) {
+                injectedCount.fetch_add(1, std::memory_order_relaxed);
+                inject = true;
+                break;
+            }
+        }
+    }
+    activeCheckers.fetch_sub(1);
+    return inject;
+}
+
+}  // namespace detail
+
+std::vector<FaultRule> parseFaultRules(std::string const& spec) {
+    std::vector<FaultRule> rules;
+    for (std::size_t start = 0; start <= spec.size();) {
+        std::size_t end = spec.find(';', start);
+        if (end == std::string::npos) end = spec.size();
+        std::string const rule = spec.substr(start, end - start);
+        start = end + 1;
+        if (!rule.empty()) rules.push_back(parseRule(rule));
+    }
+    return rules;
+}
+
+void setFaultRules(std::vector<FaultRule> const& rules) { installRules(rules); }
+
+void setFaultRules(std::string const& spec) { installRules(parseFaultRules(spec)); }
+
+void clearFaultRules() { installRules(std::vector<FaultRule>()); }
+
+std::uint64_t getInjectedFaultCount() noexcept { return injectedCount.load(std::memory_order_relaxed); }
+
+}  // namespace exceptions
+}  // namespace pex
+}  // namespace lsst
@@ -0,0 +1,294 @@
+/*
+ * This file is part of pex_exceptions.
+ *
+ * Developed for the LSST Data Management System.
+ * This product includes software developed by the LSST Project
+ * (https://www.lsst.org).
+ * See the COPYRIGHT file at the top-level directory of this distribution
+ * for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <typeinfo>
+
+#include <cxxabi.h>
+#include <unistd.h>
+
+#include "lsst/pex/exceptions/Exception.h"
+#include "lsst/pex/exceptions/FlightRecorder.h"
+
+namespace lsst {
+namespace pex {
+namespace exceptions {
+namespace {
+
+std::size_t const MESSAGE_WORDS = (FLIGHT_RECORDER_MESSAGE_LENGTH + 1) / sizeof(std::uint64_t);
+
+static_assert((FLIGHT_RECORDER_CAPACITY & (FLIGHT_RECORDER_CAPACITY - 1)) == 0,
+              "FLIGHT_RECORDER_CAPACITY must be a power of two");
+static_assert(MESSAGE_WORDS * sizeof(std::uint64_t) == FLIGHT_RECORDER_MESSAGE_LENGTH + 1,
+              "FLIGHT_RECORDER_MESSAGE_LENGTH + 1 must be a multiple of 8");
+
+/*
+ * One ring buffer entry, protected by a sequence lock: `sequence` is 2*n + 1 while the n-th record
+ * is being written and 2*n + 2 once it is complete.  Every field is atomic so readers racing with a
+ * writer are well-defined; they detect the race from the sequence number and discard the entry.
+ */
+struct Slot {
+    std::atomic<std::uint64_t> sequence;
+    std::atomic<std::int64_t> timestamp;
+    std::atomic<TracepointSite const*> site;
+    std::atomic<std::uint64_t> message[MESSAGE_WORDS];
+};
+
+// Values of recorderState.
+int const STATE_UNKNOWN = 0;  // environment not yet read
+int const STATE_ENABLED = 1;
+int const STATE_DISABLED = 2;
+
+// All of these are constant-initialized, so exceptions thrown during static initialization are safe.
+Slot slots[FLIGHT_RECORDER_CAPACITY];
+std::atomic<std::uint64_t> nextRecord(0);
+std::atomic<int> recorderState(STATE_UNKNOWN);
+
+int readStateFromEnvironment() noexcept {
+    char const* value = std::getenv("LSST_EXCEPT_FLIGHT_RECORDER");
+    int state = (value && (std::strcmp(value, "0") == 0 || std::strcmp(value, "off") == 0))
+                        ? STATE_DISABLED
+                        : STATE_ENABLED;
+    int expected = STATE_UNKNOWN;
+    recorderState.compare_exchange_strong(expected, state, std::memory_order_relaxed);
+    return recorderState.load(std::memory_order_relaxed);
+}
+
+// A copy of one slot, taken without tearing.
+struct Snapshot {
+    std::int64_t timestamp;
+    TracepointSite const* site;
+    char message[FLIGHT_RECORDER_MESSAGE_LENGTH + 1];
+};
+
+// Copy the n-th record; returns false if it has been overwritten or is being written.
+bool readRecord(std::uint64_t n, Snapshot& out) noexcept {
+    Slot const& slot = slots[n & (FLIGHT_RECORDER_CAPACITY - 1)];
+    std::uint64_t const expected = 2 * n + 2;
+    if (slot.sequence.load(std::memory_order_acquire) != expected) return false;
+    out.timestamp = slot.timestamp.load(std::memory_order_relaxed);
+    out.site = slot.site.load(std::memory_order_relaxed);
+    std::uint64_t words[MESSAGE_WORDS];
+    for (std::size_t i = 0; i != MESSAGE_WORDS; ++i) {
+        words[i] = slot.message[i].load(std::memory_order_relaxed);
+    }
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (slot.sequence.load(std::memory_order_relaxed) != expected) return false;
+    std::memcpy(out.message, words, sizeof(words));
+    out.message[FLIGHT_RECORDER_MESSAGE_LENGTH] = '\0';
+    return true;
+}
+
+// Return the index of the first record to report when asked for at most `n`.
+std::uint64_t firstRecord(std::uint64_t end, std::size_t n) noexcept {
+    std::uint64_t count = std::min<std::uint64_t>(n, FLIGHT_RECORDER_CAPACITY);
+    return end > count ? end - count : 0;
+}
+
+// Fixed-size line buffer for async-signal-safe output.
+class LineWriter {
+public:
+    explicit LineWriter(int fd) noexcept : _fd(fd), _size(0) {}
+
+    void append(char const* text) noexcept {
+        for (; text && *text && _size < sizeof(_buffer); ++text) _buffer[_size++] = *text;
+    }
+
+    void append(std::int64_t value) noexcept {
+        char digits[24];
+        std::size_t n = 0;
+        std::uint64_t magnitude = value < 0 ? -static_cast<std::uint64_t>(value) : value;
+        do {
+            digits[n++] = '0' + magnitude % 10;
+            magnitude /= 10;
+        } while (magnitude);
+        if (value < 0) digits[n++] = '-';
+        while (n && _size < sizeof(_buffer)) _buffer[_size++] = digits[--n];
+    }
+
+    void appendHex(std::uint64_t value) noexcept {
+        for (int shift = 60; shift >= 0 && _size < sizeof(_buffer); shift -= 4) {
+            _buffer[_size++] = "0123456789abcdef"[(value >> shift) & 0xf];
+        }
+    }
+
+    void flush() noexcept {
+        if (_size == sizeof(_buffer)) _buffer[_size - 1] = '\n';
+        for (std::size_t done = 0; done < _size;) {
+            ssize_t written = ::write(_fd, _buffer + done, _size - done);
+            if (written <= 0) break;
+            done += written;
+        }
+        _size = 0;
+    }
+
+private:
+    int _fd;
+    std::size_t _size;
+    char _buffer[1024];
+};
+
+int const FATAL_SIGNALS[] = {SIGSEGV, SIGBUS, SIGILL, SIGFPE, SIGABRT};
+struct sigaction previousActions[sizeof(FATAL_SIGNALS) / sizeof(FATAL_SIGNALS[0])];
+
+void handleFatalSignal(int signal) {
+    static char const header[] = "Recently created LSST exceptions (oldest first):\n";
+    ssize_t ignored = ::write(STDERR_FILENO, header, sizeof(header) - 1);
+    (void)ignored;
+    dumpRecentExceptions(STDERR_FILENO);
+    for (std::size_t i = 0; i != sizeof(FATAL_SIGNALS) / sizeof(FATAL_SIGNALS[0]); ++i) {
+        if (FATAL_SIGNALS[i] == signal) sigaction(signal, &previousActions[i], nullptr);
+    }
+    raise(signal);
+}
+
+}  // namespace
+
+namespace detail {
+
+void recordException(TracepointSite const* site, std::string const& message) noexcept {
+    int state = recorderState.load(std::memory_order_relaxed);
+    if (state == STATE_UNKNOWN) state = readStateFromEnvironment();
+    if (state != STATE_ENABLED) return;
+
+    std::uint64_t const n = nextRecord.fetch_add(1, std::memory_order_relaxed);
+    Slot& slot = slots[n & (FLIGHT_RECORDER_CAPACITY - 1)];
+    std::uint64_t words[MESSAGE_WORDS] = {};
+    std::memcpy(words, message.data(), std::min(message.size(), FLIGHT_RECORDER_MESSAGE_LENGTH));
+    std::int64_t const timestamp = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                           std::chrono::system_clock::now().time_since_epoch())
+                                           .count();
+
+    slot.sequence.store(2 * n + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.timestamp.store(timestamp, std::memory_order_relaxed);
+    slot.site.store(site, std::memory_order_relaxed);
+    for (std::size_t i = 0; i != MESSAGE_WORDS; ++i) {
+        slot.message[i].store(words[i], std::memory_order_relaxed);
+    }
+    slot.sequence.store(2 * n + 2, std::memory_order_release);
+}
+
+}  // namespace detail
+
+std::vector<ExceptionRecord> getRecentExceptions(std::size_t n) {
+    std::vector<ExceptionRecord> result;
+    std::uint64_t const end = nextRecord.load(std::memory_order_acquire);
+    for (std::uint64_t i = firstRecord(end, n); i < end; ++i) {
+        Snapshot snapshot;
+        if (!readRecord(i, snapshot)) continue;
+        ExceptionRecord record;
+        record.timestamp = snapshot.timestamp;
+        record.line = 0;
+        if (snapshot.site) {
+            if (snapshot.site->_type) {
+                int status = 0;
+                std::unique_ptr<char, void (*)(void*)> demangled(
+                        abi::__cxa_demangle(snapshot.site->_type->name(), nullptr, nullptr, &status),
+                        std::free);
+                record.type = (status == 0 && demangled) ? demangled.get() : snapshot.site->_type->name();
+            }
+            record.file = snapshot.site->getFile();
+            record.line = snapshot.site->_line;
+            record.function = snapshot.site->getFunction();
+        }
+        record.message = snapshot.message;
+        result.push_back(std::move(record));
+    }
+    return result;
+}
+
+void dumpRecentExceptions(int fd, std::size_t n) noexcept {
+    std::uint64_t const end = nextRecord.load(std::memory_order_acquire);
+    LineWriter writer(fd);
+    for (std::uint64_t i = firstRecord(end, n); i < end; ++i) {
+        Snapshot snapshot;
+        if (!readRecord(i, snapshot)) continue;
+        writer.append("[");
+        writer.append(snapshot.timestamp / 1000000000);
+        writer.append(".");
+        std::int64_t const nanoseconds = snapshot.timestamp % 1000000000;
+        for (std::int64_t scale = 100000000; scale > 1 && nanoseconds < scale; scale /= 10) {
+            writer.append("0");
+        }
+        writer.append(nanoseconds);
+        writer.append("] ");
+        if (snapshot.site) {
+            writer.append(snapshot.site->_type ? snapshot.site->_type->name() : "?");
+            writer.append(" at ");
+            if (snapshot.site->_file) {
+                writer.append(snapshot.site->_file);
+            } else {
+                // Looking up a site ID is not async-signal-safe.
+                writer.append("<site 0x");
+                writer.appendHex(snapshot.site->_hash);
+                writer.append(">");
+            }
+            writer.append(":");
+            writer.append(static_cast<std::int64_t>(snapshot.site->_line));
+            if (char const* func = snapshot.site->getCompiledFunction()) {
+                writer.append(" in ");
+                writer.append(func);
+            }
+        } else {
+            writer.append("(unknown location)");
+        }
+        writer.append(": ");
+        writer.append(snapshot.message);
+        writer.append("\n");
+        writer.flush();
+    }
+}
+
+void setFlightRecorderEnabled(bool enabled) noexcept {
+    recorderState.store(enabled ? STATE_ENABLED : STATE_DISABLED, std::memory_order_relaxed);
+}
+
+bool isFlightRecorderEnabled() noexcept {
+    int state = recorderState.load(std::memory_order_relaxed);
+    if (state == STATE_UNKNOWN) state = readStateFromEnvironment();
+    return state == STATE_ENABLED;
+}
+
+void installFlightRecorderSignalHandlers() {
+    // Installing twice would make our handlers their own previous handlers.
+    static std::atomic<bool> installed(false);
+    if (installed.exchange(true)) return;
+    struct sigaction action;
+    std::memset(&action, 0, sizeof(action));
+    action.sa_handler = handleFatalSignal;
+    sigemptyset(&action.sa_mask);
+    for (std::size_t i = 0; i != sizeof(FATAL_SIGNALS) / sizeof(FATAL_SIGNALS[0]); ++i) {
+        sigaction(FATAL_SIGNALS[i], &action, &previousActions[i]);
+    }
+}
+
+}  // namespace exceptions
+}  // namespace pex
+}  // namespace lsst
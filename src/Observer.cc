@@ -0,0 +1,124 @@
+/*
+ * This file is part of pex_exceptions.
+ *
+ * Developed for the LSST Data Management System.
+ * This product includes software developed by the LSST Project
+ * (https://www.lsst.org).
+ * See the COPYRIGHT file at the top-level directory of this distribution
+ * for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "lsst/pex/exceptions/Exception.h"
+#include "lsst/pex/exceptions/Observer.h"
+#include "lsst/pex/exceptions/Runtime.h"
+
+namespace lsst {
+namespace pex {
+namespace exceptions {
+namespace {
+
+struct Registration {
+    std::size_t id;
+    ExceptionObserver observer;
+};
+typedef std::vector<Registration> ObserverList;
+
+/*
+ * The registered observers are an immutable list that is replaced as a whole (copy-on-write).  The
+ * pointer to the current list is only read or written with registryMutex held; notifying threads hold
+ * it just long enough to take a reference to the list, and call the observers without it.
+ */
+std::mutex registryMutex;
+std::shared_ptr<ObserverList const> registry;
+std::size_t nextId = 1;
+
+thread_local bool notifying = false;
+
+/*
+ * Replace the registered observers and return the old list.  Requires registryMutex.
+ *
+ * Callers should let the old list go only after releasing the mutex, as destroying an observer may
+ * block (e.g. on the Python GIL).
+ */
+std::shared_ptr<ObserverList const> publish(std::shared_ptr<ObserverList const> list) {
+    detail::observersActive.store(!list->empty(), std::memory_order_relaxed);
+    registry.swap(list);
+    return list;
+}
+
+// Return the current list of observers, which may be null.
+std::shared_ptr<ObserverList const> snapshot() {
+    std::lock_guard<std::mutex> lock(registryMutex);
+    return registry;
+}
+
+}  // namespace
+
+namespace detail {
+
+std::atomic<bool> observersActive(false);
+
+void notifyObservers(Exception const& exception, Tracepoint const& tracepoint,
+                     ExceptionEvent event) noexcept {
+    if (notifying) return;
+    std::shared_ptr<ObserverList const> list = snapshot();
+    if (!list) return;
+    notifying = true;
+    for (Registration const& registration : *list) {
+        try {
+            registration.observer(exception, tracepoint, event);
+        } catch (...) {
+        }
+    }
+    notifying = false;
+}
+
+}  // namespace detail
+
+std::size_t addExceptionObserver(ExceptionObserver observer) {
+    if (!observer) {
+        throw LSST_EXCEPT(InvalidParameterError, "Exception observer must not be empty");
+    }
+    std::shared_ptr<ObserverList const> old;  // destroyed after the lock is released
+    std::lock_guard<std::mutex> lock(registryMutex);
+    auto list = registry ? std::make_shared<ObserverList>(*registry) : std::make_shared<ObserverList>();
+    std::size_t const id = nextId++;
+    list->push_back(Registration{id, std::move(observer)});
+    old = publish(std::move(list));
+    return id;
+}
+
+bool removeExceptionObserver(std::size_t id) {
+    std::shared_ptr<ObserverList const> old;  // destroyed after the lock is released
+    std::lock_guard<std::mutex> lock(registryMutex);
+    if (!registry) return false;
+    auto list = std::make_shared<ObserverList>();
+    for (Registration const& registration : *registry) {
+        if (registration.id != id) list->push_back(registration);
+    }
+    if (list->size() == registry->size()) return false;
+    old = publish(std::move(list));
+    return true;
+}
+
+}  // namespace exceptions
+}  // namespace pex
+}  // namespace lsst
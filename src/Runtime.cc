@@ -0,0 +1,45 @@
+/*
+ * This file is part of pex_exceptions.
+ *
+ * Developed for the LSST Data Management System.
+ * This product includes software developed by the LSST Project
+ * (https://www.lsst.org).
+ * See the COPYRIGHT file at the top-level directory of this distribution
+ * for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "lsst/pex/exceptions/Runtime.h"
+
+namespace lsst {
+namespace pex {
+namespace exceptions {
+
+LSST_EXCEPTION_TYPE_DEFINE(LogicError, lsst::pex::exceptions::LogicError)
+LSST_EXCEPTION_TYPE_DEFINE(DomainError, lsst::pex::exceptions::DomainError)
+LSST_EXCEPTION_TYPE_DEFINE(InvalidParameterError, lsst::pex::exceptions::InvalidParameterError)
+LSST_EXCEPTION_TYPE_DEFINE(LengthError, lsst::pex::exceptions::LengthError)
+LSST_EXCEPTION_TYPE_DEFINE(OutOfRangeError, lsst::pex::exceptions::OutOfRangeError)
+LSST_EXCEPTION_TYPE_DEFINE(RuntimeError, lsst::pex::exceptions::RuntimeError)
+LSST_EXCEPTION_TYPE_DEFINE(RangeError, lsst::pex::exceptions::RangeError)
+LSST_EXCEPTION_TYPE_DEFINE(OverflowError, lsst::pex::exceptions::OverflowError)
+LSST_EXCEPTION_TYPE_DEFINE(UnderflowError, lsst::pex::exceptions::UnderflowError)
+LSST_EXCEPTION_TYPE_DEFINE(NotFoundError, lsst::pex::exceptions::NotFoundError)
+LSST_EXCEPTION_TYPE_DEFINE(IoError, lsst::pex::exceptions::IoError)
+LSST_EXCEPTION_TYPE_DEFINE(TypeError, lsst::pex::exceptions::TypeError)
+
+}  // namespace exceptions
+}  // namespace pex
+}  // namespace lsst
@@ -0,0 +1,198 @@
+/*
+ * This file is part of pex_exceptions.
+ *
+ * Developed for the LSST Data Management System.
+ * This product includes software developed by the LSST Project
+ * (https://www.lsst.org).
+ * See the COPYRIGHT file at the top-level directory of this distribution
+ * for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <mutex>
+#include <set>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+
+#include <link.h>
+#include <unistd.h>
+
+#include "lsst/pex/exceptions/Exception.h"
+#include "lsst/pex/exceptions/Runtime.h"
+#include "lsst/pex/exceptions/SiteMap.h"
+
+namespace lsst {
+namespace pex {
+namespace exceptions {
+namespace {
+
+struct SiteNames {
+    std::string file;
+    std::string function;
+};
+
+/*
+ * The loaded site maps.  Entries are never modified or removed once inserted, so the strings returned
+ * by lookups remain valid; unordered_map does not move its elements when it grows.
+ */
+struct SiteMaps {
+    std::mutex mutex;
+    std::unordered_map<std::uint64_t, SiteNames> names;
+    std::unordered_map<std::uint64_t, SiteNames> unknown;  // placeholders for sites not in any map
+    std::set<std::string> tried;                           // paths already loaded or found missing
+    bool environmentRead = false;
+};
+
+// Never destroyed, so exceptions can be formatted during static destruction.
+SiteMaps& getSiteMaps() {
+    static SiteMaps* maps = new SiteMaps;
+    return *maps;
+}
+
+/*
+ * Add the sites in a map file; returns false if it cannot be opened.  Each line holds the site ID in
+ * hexadecimal, the line, the file and the function, separated by tabs; lines starting with '#' and
+ * lines that cannot be parsed are skipped.  The caller must hold the mutex.
+ */
+bool readSiteMap(SiteMaps& maps, std::string const& path) {
+    maps.tried.insert(path);
+    std::ifstream stream(path);
+    if (!stream) return false;
+    std::string text;
+    while (std::getline(stream, text)) {
+        if (text.empty() || text[0] == '#') continue;
+        std::size_t const idEnd = text.find('\t');
+        std::size_t const lineEnd = text.find('\t', idEnd + 1);
+        std::size_t const fileEnd = text.find('\t', lineEnd + 1);
+        if (idEnd == std::string::npos || lineEnd == std::string::npos || fileEnd == std::string::npos) {
+            continue;
+        }
+        char* end = nullptr;
+        std::uint64_t const id = std::strtoull(text.c_str(), &end, 16);
+        if (end != text.c_str() + idEnd) continue;
+        SiteNames names;
+        names.file = text.substr(lineEnd + 1, fileEnd - lineEnd - 1);
+        names.function = text.substr(fileEnd + 1);
+        maps.names.emplace(id, std::move(names));
+    }
+    return true;
+}
+
+// Load the maps named in LSST_EXCEPT_SITE_MAPS, once.  The caller must hold the mutex.
+void readEnvironment(SiteMaps& maps) {
+    if (maps.environmentRead) return;
+    maps.environmentRead = true;
+    char const* value = std::getenv("LSST_EXCEPT_SITE_MAPS");
+    if (!value) return;
+    std::istringstream paths(value);
+    std::string path;
+    while (std::getline(paths, path, ':')) {
+        if (!path.empty() && !maps.tried.count(path)) readSiteMap(maps, path);
+    }
+}
+
+struct ObjectSearch {
+    std::uintptr_t address;
+    std::string path;
+    bool found;
+};
+
+int findObjectCallback(dl_phdr_info* info, std::size_t, void* data) {
+    ObjectSearch& search = *static_cast<ObjectSearch*>(data);
+    for (int i = 0; i != info->dlpi_phnum; ++i) {
+        ElfW(Phdr) const& header = info->dlpi_phdr[i];
+        if (header.p_type != PT_LOAD) continue;
+        std::uintptr_t const start = info->dlpi_addr + header.p_vaddr;
+        if (search.address >= start && search.address < start + header.p_memsz) {
+            search.path = info->dlpi_name ? info->dlpi_name : "";
+            search.found = true;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+// Return the path of the loaded object (shared library or executable) containing an address.
+std::string findObject(void const* address) {
+    ObjectSearch search{reinterpret_cast<std::uintptr_t>(address), std::string(), false};
+    dl_iterate_phdr(findObjectCallback, &search);
+    if (search.found && search.path.empty()) {
+        // The main program has no name here.
+        char buffer[4096];
+        ssize_t const length = ::readlink("/proc/self/exe", buffer, sizeof(buffer));
+        if (length > 0) search.path.assign(buffer, length);
+    }
+    return search.path;
+}
+
+// Return the names of a site that only has an ID, loading the map for its object if necessary.
+SiteNames const& lookup(TracepointSite const& site) {
+    SiteMaps& maps = getSiteMaps();
+    std::lock_guard<std::mutex> lock(maps.mutex);
+    readEnvironment(maps);
+    auto iter = maps.names.find(site._hash);
+    if (iter != maps.names.end()) return iter->second;
+    std::string const object = findObject(&site);
+    if (!object.empty() && !maps.tried.count(object + ".sites")) {
+        readSiteMap(maps, object + ".sites");
+        iter = maps.names.find(site._hash);
+        if (iter != maps.names.end()) return iter->second;
+    }
+    auto placeholder = maps.unknown.find(site._hash);
+    if (placeholder == maps.unknown.end()) {
+        char file[32];
+        std::snprintf(file, sizeof(file), "<site 0x%016" PRIx64 ">", site._hash);
+        placeholder = maps.unknown.emplace(site._hash, SiteNames{file, "<unknown>"}).first;
+    }
+    return placeholder->second;
+}
+
+}  // namespace
+
+char const* TracepointSite::_lookupFile(void) const noexcept {
+    try {
+        return lookup(*this).file.c_str();
+    } catch (...) {
+        return "<unknown>";  // out of memory
+    }
+}
+
+char const* TracepointSite::_lookupFunction(void) const noexcept {
+    try {
+        return lookup(*this).function.c_str();
+    } catch (...) {
+        return "<unknown>";
+    }
+}
+
+void loadSiteMap(std::string const& path) {
+    SiteMaps& maps = getSiteMaps();
+    bool read;
+    {
+        std::lock_guard<std::mutex> lock(maps.mutex);
+        read = readSiteMap(maps, path);
+    }
+    if (!read) throw LSST_EXCEPT_ERRNO(IoError, "Cannot read site map", path);
+}
+
+}  // namespace exceptions
+}  // namespace pex
+}  // namespace lsst
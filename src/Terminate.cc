@@ -0,0 +1,230 @@
+/*
+ * This file is part of pex_exceptions.
+ *
+ * Developed for the LSST Data Management System.
+ * This product includes software developed by the LSST Project
+ * (https://www.lsst.org).
+ * See the COPYRIGHT file at the top-level directory of this distribution
+ * for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <atomic>
+#include <csignal>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <typeinfo>
+
+#include <cxxabi.h>
+#include <unistd.h>
+
+#include "lsst/pex/exceptions/Exception.h"
+#include "lsst/pex/exceptions/Terminate.h"
+
+namespace lsst {
+namespace pex {
+namespace exceptions {
+namespace {
+
+// Maximum number of causes to report, in case of a cycle.
+int const MAX_CAUSES = 16;
+
+// Text writer over a fixed buffer; text that does not fit is dropped, and the report marked truncated.
+class ReportWriter {
+public:
+    ReportWriter(char* buffer, std::size_t capacity) noexcept
+            : _buffer(buffer), _capacity(capacity), _size(0), _truncated(false) {}
+
+    void append(char const* text, std::size_t length) noexcept {
+        for (std::size_t i = 0; i != length; ++i) {
+            if (_size == _capacity) {
+                _truncated = true;
+                return;
+            }
+            _buffer[_size++] = text[i];
+        }
+    }
+
+    void append(char const* text) noexcept {
+        if (text) append(text, std::strlen(text));
+    }
+
+    void append(std::int64_t value) noexcept {
+        char digits[24];
+        std::size_t n = 0;
+        std::uint64_t magnitude = value < 0 ? -static_cast<std::uint64_t>(value) : value;
+        do {
+            digits[n++] = '0' + magnitude % 10;
+            magnitude /= 10;
+        } while (magnitude);
+        if (value < 0) digits[n++] = '-';
+        while (n) append(&digits[--n], 1);
+    }
+
+    void appendHex(std::uint64_t value) noexcept {
+        for (int shift = 60; shift >= 0; shift -= 4) append(&"0123456789abcdef"[(value >> shift) & 0xf], 1);
+    }
+
+    void write(int fd) noexcept {
+        static char const marker[] = "\n[report truncated]\n";
+        if (_truncated) {
+            std::size_t const length = sizeof(marker) - 1;
+            std::memcpy(_buffer + _capacity - length, marker, length);
+        }
+        for (std::size_t done = 0; done < _size;) {
+            ssize_t written = ::write(fd, _buffer + done, _size - done);
+            if (written <= 0) break;
+            done += written;
+        }
+    }
+
+private:
+    char* _buffer;
+    std::size_t _capacity;
+    std::size_t _size;
+    bool _truncated;
+};
+
+char reportBuffer[TERMINATE_REPORT_CAPACITY];
+std::atomic_flag reportBusy = ATOMIC_FLAG_INIT;
+std::atomic<bool> reported(false);
+
+std::terminate_handler previousTerminate = nullptr;
+
+int const FATAL_SIGNALS[] = {SIGSEGV, SIGBUS, SIGILL, SIGFPE, SIGABRT};
+struct sigaction previousActions[sizeof(FATAL_SIGNALS) / sizeof(FATAL_SIGNALS[0])];
+
+// Append the report of an exception, following the layout of Exception::addToStream.
+void appendException(ReportWriter& writer, std::exception_ptr const& current, int depth) noexcept {
+    try {
+        std::rethrow_exception(current);
+    } catch (Exception const& e) {
+        Traceback const& traceback = e.getTraceback();
+        char const* type = e.getType();  // ends with " *"
+        std::size_t const typeLength = std::strlen(type) - 2;
+        if (traceback.empty()) {
+            writer.append(" ");
+            writer.append(type, typeLength);
+            writer.append(": ");
+            writer.append(e.what());
+            writer.append("\n");
+        } else {
+            writer.append("\n");
+            for (std::size_t i = 0; i != traceback.size(); ++i) {
+                // Looking up a site ID may allocate, so sites that only have an ID are left as they are.
+                TracepointSite const& site = *traceback[i]._site;
+                writer.append("  File \"");
+                if (site._file) {
+                    writer.append(site._file);
+                } else {
+                    writer.append("<site 0x");
+                    writer.appendHex(site._hash);
+                    writer.append(">");
+                }
+                writer.append("\", line ");
+                writer.append(static_cast<std::int64_t>(site._line));
+                writer.append(", in ");
+                char const* func = site.getCompiledFunction();
+                writer.append(func ? func : "<unknown>");
+                writer.append("\n    ");
+                writer.append(traceback[i]._message.c_str());
+                writer.append(" {");
+                writer.append(static_cast<std::int64_t>(i));
+                writer.append("}\n");
+            }
+            writer.append(type, typeLength);
+            writer.append(": '");
+            writer.append(e.what());
+            writer.append("'\n");
+        }
+        if (e.getCause() && depth < MAX_CAUSES) {
+            writer.append("Caused by:");
+            appendException(writer, e.getCause(), depth + 1);
+        }
+    } catch (std::exception const& e) {
+        writer.append(" ");
+        writer.append(abi::__cxa_current_exception_type()->name());
+        writer.append(": ");
+        writer.append(e.what());
+        writer.append("\n");
+    } catch (...) {
+        std::type_info const* type = abi::__cxa_current_exception_type();
+        writer.append(" exception of type ");
+        writer.append(type ? type->name() : "unknown");
+        writer.append("\n");
+    }
+}
+
+// Report the current exception, unless an earlier handler has already reported one.
+void reportOnce(char const* header) noexcept {
+    if (reported.load(std::memory_order_relaxed)) return;
+    if (writeCurrentException(STDERR_FILENO, header)) reported.store(true, std::memory_order_relaxed);
+}
+
+[[noreturn]] void handleTerminate() {
+    reportOnce("terminate called after throwing:");
+    if (previousTerminate) previousTerminate();
+    std::abort();
+}
+
+void handleFatalSignal(int signal) {
+    reportOnce("fatal signal received while handling:");
+    for (std::size_t i = 0; i != sizeof(FATAL_SIGNALS) / sizeof(FATAL_SIGNALS[0]); ++i) {
+        if (FATAL_SIGNALS[i] == signal) sigaction(signal, &previousActions[i], nullptr);
+    }
+    raise(signal);
+}
+
+}  // namespace
+
+bool writeCurrentException(int fd, char const* header) noexcept {
+    std::exception_ptr current = std::current_exception();
+    if (!current) return false;
+    // The buffer is static, so reports from other threads (or from a signal arriving during a report)
+    // are dropped rather than waited for.
+    if (reportBusy.test_and_set(std::memory_order_acquire)) return false;
+    ReportWriter writer(reportBuffer, sizeof(reportBuffer));
+    writer.append(header);
+    appendException(writer, current, 0);
+    writer.write(fd);
+    reportBusy.clear(std::memory_order_release);
+    return true;
+}
+
+void installTerminateHandler() {
+    std::terminate_handler previous = std::get_terminate();
+    if (previous == handleTerminate) return;
+    previousTerminate = previous;
+    std::set_terminate(handleTerminate);
+}
+
+void installTerminateSignalHandlers() {
+    // Installing twice would make our handlers their own previous handlers.
+    static std::atomic<bool> installed(false);
+    if (installed.exchange(true)) return;
+    struct sigaction action;
+    std::memset(&action, 0, sizeof(action));
+    action.sa_handler = handleFatalSignal;
+    sigemptyset(&action.sa_mask);
+    for (std::size_t i = 0; i != sizeof(FATAL_SIGNALS) / sizeof(FATAL_SIGNALS[0]); ++i) {
+        sigaction(FATAL_SIGNALS[i], &action, &previousActions[i]);
+    }
+}
+
+}  // namespace exceptions
+}  // namespace pex
+}  // namespace lsst
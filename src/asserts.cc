@@ -0,0 +1,89 @@
+/*
+ * This file is part of pex_exceptions.
+ *
+ * Developed for the LSST Data Management System.
+ * This product includes software developed by the LSST Project
+ * (https://www.lsst.org).
+ * See the COPYRIGHT file at the top-level directory of this distribution
+ * for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <ostream>
+#include <string>
+
+#include "boost/format.hpp"
+
+#include "lsst/pex/exceptions/asserts.h"
+
+namespace lsst {
+namespace pex {
+namespace exceptions {
+namespace detail {
+namespace {
+
+// Streams a CheckValue of kind OTHER with its own operator<<.
+struct OtherValue {
+    CheckValue const& value;
+};
+
+std::ostream& operator<<(std::ostream& stream, OtherValue const& other) {
+    other.value.write(stream, other.value.pointerValue);
+    return stream;
+}
+
+void feed(boost::format& format, CheckValue const& value) {
+    switch (value.kind) {
+        case CheckValue::SIGNED:
+            format % value.signedValue;
+            break;
+        case CheckValue::UNSIGNED:
+            format % value.unsignedValue;
+            break;
+        case CheckValue::FLOATING:
+            format % value.floatingValue;
+            break;
+        case CheckValue::CHARACTER:
+            format % static_cast<char>(value.signedValue);
+            break;
+        case CheckValue::STRING:
+            format % value.stringValue;
+            break;
+        case CheckValue::POINTER:
+            format % value.pointerValue;
+            break;
+        case CheckValue::OTHER:
+            format % OtherValue{value};
+            break;
+    }
+}
+
+}  // namespace
+
+std::string formatCheckMessage(char const* format, CheckValue const& n1, CheckValue const& n2) {
+    CheckValue const values[] = {n1, n2};
+    return formatCheckMessage(format, values, 2);
+}
+
+std::string formatCheckMessage(char const* format, CheckValue const* values, std::size_t nValues) {
+    boost::format result(format);
+    for (std::size_t i = 0; i != nValues; ++i) feed(result, values[i]);
+    return result.str();
+}
+
+}  // namespace detail
+}  // namespace exceptions
+}  // namespace pex
+}  // namespace lsst
@@ -0,0 +1,43 @@
+/*
+ * This file is part of pex_exceptions.
+ *
+ * Developed for the LSST Data Management System.
+ * This product includes software developed by the LSST Project
+ * (https://www.lsst.org).
+ * See the COPYRIGHT file at the top-level directory of this distribution
+ * for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+// A failing LSST_CHECK in a template argument must stop compilation, naming its message.
+//
+// EXPECTED: checkFailedInConstantExpression
+// EXPECTED: kernel width must be odd
+
+#include <array>
+
+#include "lsst/pex/exceptions/asserts.h"
+
+namespace pexExcept = lsst::pex::exceptions;
+
+constexpr int kernelCenter(int width) {
+    LSST_CHECK(width % 2 == 1, pexExcept::InvalidParameterError, "kernel width must be odd");
+    return width / 2;
+}
+
+std::array<double, kernelCenter(5)> passing;
+#ifndef LSST_COMPILE_FAIL_CONTROL
+std::array<double, kernelCenter(4)> failing;
+#endif
@@ -0,0 +1,41 @@
+/*
+ * This file is part of pex_exceptions.
+ *
+ * Developed for the LSST Data Management System.
+ * This product includes software developed by the LSST Project
+ * (https://www.lsst.org).
+ * See the COPYRIGHT file at the top-level directory of this distribution
+ * for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+// A failing LSST_CHECK_NOT_NULL in a constant expression must stop compilation, naming its message.
+//
+// EXPECTED: checkFailedInConstantExpression
+// EXPECTED: no name given
+
+#include "lsst/pex/exceptions/asserts.h"
+
+namespace pexExcept = lsst::pex::exceptions;
+
+constexpr char initial(char const* name) {
+    LSST_CHECK_NOT_NULL(name, pexExcept::InvalidParameterError, "no name given");
+    return name[0];
+}
+
+static_assert(initial("lsst") == 'l', "passing check");
+#ifndef LSST_COMPILE_FAIL_CONTROL
+static_assert(initial(nullptr) == 'l', "failing check");
+#endif
@@ -21,12 +21,14 @@
  * along with this program.  If not, see <https://www.gnu.org/licenses/>.
  */
 
+#include <cerrno>
 #include <string>
 
 #include <pybind11/pybind11.h>
 
 #include "lsst/pex/exceptions/Exception.h"
 #include "lsst/pex/exceptions/Runtime.h"
+#include "lsst/pex/exceptions/asserts.h"
 #include "lsst/pex/exceptions/python/Exception.h"
 
 using namespace lsst::pex::exceptions;
@@ -48,6 +50,35 @@ void fail2(std::string const &message1, std::string const &message2) {
     }
 }
 
+void failIoErrorErrno(int errnum, std::string const &path) {
+    errno = errnum;
+    throw LSST_EXCEPT_ERRNO(IoError, "Failed to open file", path);
+}
+
+void failWithCause(std::string const &message1, std::string const &message2) {
+    try {
+        fail1<NotFoundError>(message1);
+    } catch (NotFoundError const &) {
+        throw LSST_EXCEPT_FROM(RuntimeError, std::current_exception(), message2);
+    }
+}
+
+void failLight() { throw LSST_EXCEPT_LIGHT(NotFoundError, "no such key"); }
+
+void failLightAdded(std::string const &message) {
+    try {
+        failLight();
+    } catch (NotFoundError &err) {
+        LSST_EXCEPT_ADD(err, message);
+        throw;
+    }
+}
+
+int checkIndex(int i, int n) {
+    LSST_CHECK_INDEX(i, n);
+    return i;
+}
+
 #define LSST_FAIL_TEST(name)                                                                 \
     mod.def("fail" #name "1", [](const std::string &message) { fail1<name>(message); });     \
     mod.def("fail" #name "2", [](const std::string &message1, const std::string &message2) { \
@@ -72,4 +103,10 @@ PYBIND11_MODULE(_testLib, mod) {
     LSST_FAIL_TEST(NotFoundError)
     LSST_FAIL_TEST(RuntimeError)
     LSST_FAIL_TEST(Exception)
+
+    mod.def("failIoErrorErrno", &failIoErrorErrno);
+    mod.def("failWithCause", &failWithCause);
+    mod.def("failLight", &failLight);
+    mod.def("failLightAdded", &failLightAdded);
+    mod.def("checkIndex", &checkIndex);
 }
@@ -0,0 +1,187 @@
+/*
+ * This file is part of pex_exceptions.
+ *
+ * Developed for the LSST Data Management System.
+ * This product includes software developed by the LSST Project
+ * (https://www.lsst.org).
+ * See the COPYRIGHT file at the top-level directory of this distribution
+ * for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <exception>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "lsst/pex/exceptions/Context.h"
+#include "lsst/pex/exceptions/Runtime.h"
+
+#define BOOST_TEST_MODULE Context
+#define BOOST_TEST_DYN_LINK
+#include "boost/test/unit_test.hpp"
+
+namespace pexExcept = lsst::pex::exceptions;
+
+namespace {
+
+int contextLine = 0;
+
+void lookup(int key) { throw LSST_EXCEPT(pexExcept::NotFoundError, "no key " + std::to_string(key)); }
+
+void processVisit(int visit, std::string const &name) {
+    contextLine = __LINE__ + 1;
+    LSST_EXCEPT_CONTEXT("while processing visit %d of %s", visit, name)([&] { lookup(visit * 10); });
+}
+
+void processAll(std::vector<int> const &visits) {
+    LSST_EXCEPT_CONTEXT("while processing %d visits", visits.size())([&] {
+        for (int visit : visits) {
+            processVisit(visit, "run" + std::to_string(visit));
+        }
+    });
+}
+
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(ContextSuite)
+
+BOOST_AUTO_TEST_CASE(unwind) {
+    try {
+        processVisit(42, "survey");
+        BOOST_FAIL("Expected NotFoundError not thrown");
+    } catch (pexExcept::NotFoundError const &e) {
+        BOOST_REQUIRE_EQUAL(e.getTraceback().size(), 2u);
+        BOOST_CHECK_EQUAL(e.getTraceback()[1]._message, "while processing visit 42 of survey");
+        BOOST_CHECK_EQUAL(e.getTraceback()[1].getLine(), contextLine);
+        BOOST_CHECK_EQUAL(e.what(), "no key 420 {0}; while processing visit 42 of survey {1}");
+    }
+}
+
+BOOST_AUTO_TEST_CASE(nested) {
+    try {
+        processAll({1, 2});
+        BOOST_FAIL("Expected NotFoundError not thrown");
+    } catch (pexExcept::NotFoundError const &e) {
+        BOOST_REQUIRE_EQUAL(e.getTraceback().size(), 3u);
+        BOOST_CHECK_EQUAL(e.getTraceback()[1]._message, "while processing visit 1 of run1");
+        BOOST_CHECK_EQUAL(e.getTraceback()[2]._message, "while processing 2 visits");
+    }
+}
+
+BOOST_AUTO_TEST_CASE(caught_inside) {
+    int visit = 3;
+    try {
+        LSST_EXCEPT_CONTEXT("outer %d", visit)([&] {
+            try {
+                LSST_EXCEPT_CONTEXT("inner %d", visit)([&] { lookup(visit); });
+            } catch (pexExcept::NotFoundError const &e) {
+                BOOST_REQUIRE_EQUAL(e.getTraceback().size(), 2u);
+                BOOST_CHECK_EQUAL(e.getTraceback()[1]._message, "inner 3");
+            }
+        });
+    } catch (...) {
+        BOOST_FAIL("Unexpected exception");
+    }
+}
+
+BOOST_AUTO_TEST_CASE(not_thrown) {
+    pexExcept::NotFoundError stored = LSST_EXCEPT(pexExcept::NotFoundError, "stored");
+    std::vector<pexExcept::NotFoundError> copies;
+    try {
+        LSST_EXCEPT_CONTEXT("guard")([&] {
+            copies.push_back(stored);  // created inside the context, but never thrown
+            throw std::runtime_error("not an LSST exception");
+        });
+        BOOST_FAIL("Expected runtime_error not thrown");
+    } catch (std::runtime_error const &) {
+    }
+    BOOST_CHECK_EQUAL(stored.getTraceback().size(), 1u);
+    BOOST_CHECK_EQUAL(copies.front().getTraceback().size(), 1u);
+}
+
+BOOST_AUTO_TEST_CASE(already_caught) {
+    std::vector<std::exception_ptr> failures;
+    try {
+        LSST_EXCEPT_CONTEXT("while processing batch %d", 7)([&] {
+            try {
+                lookup(1);
+            } catch (...) {
+                failures.push_back(std::current_exception());
+            }
+            throw std::runtime_error("not an LSST exception");
+        });
+        BOOST_FAIL("Expected runtime_error not thrown");
+    } catch (std::runtime_error const &) {
+    }
+    BOOST_REQUIRE_EQUAL(failures.size(), 1u);
+    try {
+        std::rethrow_exception(failures.front());
+    } catch (pexExcept::NotFoundError const &e) {
+        BOOST_CHECK_EQUAL(e.getTraceback().size(), 1u);
+        BOOST_CHECK_EQUAL(e.what(), "no key 1");
+    }
+}
+
+BOOST_AUTO_TEST_CASE(return_value) {
+    int visit = 5;
+    int result = LSST_EXCEPT_CONTEXT("while doubling %d", visit)([&] { return 2 * visit; });
+    BOOST_CHECK_EQUAL(result, 10);
+}
+
+BOOST_AUTO_TEST_CASE(rethrow_copy) {
+    try {
+        LSST_EXCEPT_CONTEXT("outer")([] {
+            try {
+                lookup(1);
+            } catch (pexExcept::NotFoundError const &e) {
+                throw e;
+            }
+        });
+    } catch (pexExcept::NotFoundError const &e) {
+        BOOST_REQUIRE_EQUAL(e.getTraceback().size(), 2u);
+        BOOST_CHECK_EQUAL(e.getTraceback()[1]._message, "outer");
+    }
+}
+
+BOOST_AUTO_TEST_CASE(bad_format) {
+    try {
+        LSST_EXCEPT_CONTEXT("values %d and %d", 1)([] { lookup(1); });
+    } catch (pexExcept::NotFoundError const &e) {
+        BOOST_REQUIRE_EQUAL(e.getTraceback().size(), 2u);
+        BOOST_CHECK_EQUAL(e.getTraceback()[1]._message, "values %d and %d");
+    }
+}
+
+BOOST_AUTO_TEST_CASE(temporary) {
+    try {
+        LSST_EXCEPT_CONTEXT("while reading %s", std::string("catalog.fits"))([] { lookup(1); });
+    } catch (pexExcept::NotFoundError const &e) {
+        BOOST_REQUIRE_EQUAL(e.getTraceback().size(), 2u);
+        BOOST_CHECK_EQUAL(e.getTraceback()[1]._message, "while reading catalog.fits");
+    }
+}
+
+BOOST_AUTO_TEST_CASE(lightweight) {
+    try {
+        LSST_EXCEPT_CONTEXT("while looking up %s", "key")(
+                [] { throw LSST_EXCEPT_LIGHT(pexExcept::NotFoundError, "no such key"); });
+    } catch (pexExcept::NotFoundError const &e) {
+        BOOST_CHECK(!e.isLightweight());
+        BOOST_CHECK_EQUAL(e.what(), "no such key {0}; while looking up key {1}");
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
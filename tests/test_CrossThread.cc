@@ -0,0 +1,103 @@
+/*
+ * This file is part of pex_exceptions.
+ *
+ * Developed for the LSST Data Management System.
+ * This product includes software developed by the LSST Project
+ * (https://www.lsst.org).
+ * See the COPYRIGHT file at the top-level directory of this distribution
+ * for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <exception>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "lsst/pex/exceptions/Gauges.h"
+#include "lsst/pex/exceptions/Runtime.h"
+
+#define BOOST_TEST_MODULE CrossThread
+#define BOOST_TEST_DYN_LINK
+#include "boost/test/unit_test.hpp"
+
+namespace pexExcept = lsst::pex::exceptions;
+
+namespace {
+
+// Messages of several sizes, so that payload strings come from every block size and from the heap.
+std::string makeMessage(int i) { return std::string(1 + (i * 37) % 1500, 'a' + i % 26); }
+
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(CrossThreadSuite)
+
+// Exceptions created on one thread, annotated on a second and destroyed on a third keep their contents.
+BOOST_AUTO_TEST_CASE(handoff) {
+    std::size_t const count = pexExcept::getLiveExceptionCount();
+    for (int round = 0; round < 20; ++round) {
+        std::vector<std::exception_ptr> pending;
+        std::thread producer([&pending, round]() {
+            for (int i = 0; i < 100; ++i) {
+                pending.push_back(std::make_exception_ptr(
+                        LSST_EXCEPT(pexExcept::NotFoundError, makeMessage(round + i))));
+            }
+        });
+        producer.join();
+        std::vector<std::exception_ptr> annotated;
+        std::thread annotator([&pending, &annotated]() {
+            for (std::exception_ptr const& ptr : pending) {
+                try {
+                    std::rethrow_exception(ptr);
+                } catch (pexExcept::NotFoundError& e) {
+                    LSST_EXCEPT_ADD(e, "while handing off");
+                    annotated.push_back(std::make_exception_ptr(e));
+                }
+            }
+            pending.clear();
+        });
+        annotator.join();
+        std::thread consumer([&annotated, round]() {
+            for (std::size_t i = 0; i != annotated.size(); ++i) {
+                try {
+                    std::rethrow_exception(annotated[i]);
+                } catch (pexExcept::NotFoundError const& e) {
+                    BOOST_REQUIRE_EQUAL(e.getTraceback().size(), 2u);
+                    BOOST_CHECK_EQUAL(e.getTraceback().front()._message, makeMessage(round + i));
+                }
+            }
+            annotated.clear();
+        });
+        consumer.join();
+    }
+    if (pexExcept::hasExceptionGauges()) BOOST_CHECK_EQUAL(pexExcept::getLiveExceptionCount(), count);
+}
+
+// An exception held by a thread_local may be destroyed after the thread has released its free blocks.
+BOOST_AUTO_TEST_CASE(threadExit) {
+    std::size_t const count = pexExcept::getLiveExceptionCount();
+    std::thread thread([]() {
+        thread_local std::unique_ptr<pexExcept::RuntimeError> held;
+        held.reset(new pexExcept::RuntimeError(LSST_EXCEPT(pexExcept::RuntimeError, makeMessage(3))));
+        for (int i = 0; i < 100; ++i) {
+            pexExcept::RuntimeError e = LSST_EXCEPT(pexExcept::RuntimeError, makeMessage(i));
+        }
+    });
+    thread.join();
+    if (pexExcept::hasExceptionGauges()) BOOST_CHECK_EQUAL(pexExcept::getLiveExceptionCount(), count);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
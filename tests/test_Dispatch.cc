@@ -0,0 +1,131 @@
+/*
+ * This file is part of pex_exceptions.
+ *
+ * Developed for the LSST Data Management System.
+ * This product includes software developed by the LSST Project
+ * (https://www.lsst.org).
+ * See the COPYRIGHT file at the top-level directory of this distribution
+ * for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <exception>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "lsst/pex/exceptions/Dispatch.h"
+#include "lsst/pex/exceptions/Runtime.h"
+
+#define BOOST_TEST_MODULE Dispatch
+#define BOOST_TEST_DYN_LINK
+#include "boost/test/unit_test.hpp"
+
+namespace pexExcept = lsst::pex::exceptions;
+
+namespace {
+
+// Handlers listed base-first, to show that order does not matter.
+std::string classify(pexExcept::Exception const& e) {
+    return pexExcept::dispatch(
+            e, [](pexExcept::Exception const&) { return std::string("Exception"); },
+            [](pexExcept::RuntimeError const&) { return std::string("RuntimeError"); },
+            [](pexExcept::OverflowError const&) { return std::string("OverflowError"); },
+            [](pexExcept::LogicError const&) { return std::string("LogicError"); });
+}
+
+int countNotFound = 0;
+
+void onNotFound(pexExcept::NotFoundError const&) { ++countNotFound; }
+
+void onOther(std::exception const&) {}
+
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(DispatchSuite)
+
+BOOST_AUTO_TEST_CASE(most_derived) {
+    for (int i = 0; i < 2; ++i) {  // the second time from the table
+        BOOST_CHECK_EQUAL(classify(LSST_EXCEPT(pexExcept::OverflowError, "")), "OverflowError");
+        BOOST_CHECK_EQUAL(classify(LSST_EXCEPT(pexExcept::RuntimeError, "")), "RuntimeError");
+        BOOST_CHECK_EQUAL(classify(LSST_EXCEPT(pexExcept::RangeError, "")), "RuntimeError");
+        BOOST_CHECK_EQUAL(classify(LSST_EXCEPT(pexExcept::IoError, "")), "RuntimeError");
+        BOOST_CHECK_EQUAL(classify(LSST_EXCEPT(pexExcept::TypeError, "")), "LogicError");
+        BOOST_CHECK_EQUAL(classify(LSST_EXCEPT(pexExcept::NotFoundError, "")), "Exception");
+        BOOST_CHECK_EQUAL(classify(LSST_EXCEPT_LIGHT(pexExcept::OverflowError, "")), "OverflowError");
+    }
+}
+
+BOOST_AUTO_TEST_CASE(modify) {
+    pexExcept::NotFoundError e = LSST_EXCEPT(pexExcept::NotFoundError, "no such key");
+    pexExcept::Exception& base = e;
+    pexExcept::dispatch(
+            base, [](pexExcept::NotFoundError& e) { LSST_EXCEPT_ADD(e, "while dispatching"); },
+            [](pexExcept::Exception&) { BOOST_FAIL("wrong handler"); });
+    BOOST_CHECK_EQUAL(e.getTraceback().size(), 2u);
+}
+
+BOOST_AUTO_TEST_CASE(functions) {
+    countNotFound = 0;
+    pexExcept::NotFoundError const e = LSST_EXCEPT(pexExcept::NotFoundError, "no such key");
+    pexExcept::dispatch(e, onOther, &onNotFound);
+    pexExcept::dispatch(static_cast<std::exception const&>(e), onOther, onNotFound);
+    BOOST_CHECK_EQUAL(countNotFound, 2);
+}
+
+BOOST_AUTO_TEST_CASE(standard) {
+    std::out_of_range const e("index");
+    auto handle = [](std::exception const& e) {
+        return pexExcept::dispatch(
+                e, [](std::exception const&) { return 0; }, [](std::logic_error const&) { return 1; },
+                [](pexExcept::Exception const&) { return 2; });
+    };
+    BOOST_CHECK_EQUAL(handle(e), 1);
+    BOOST_CHECK_EQUAL(handle(std::runtime_error("")), 0);
+    BOOST_CHECK_EQUAL(handle(LSST_EXCEPT(pexExcept::LogicError, "")), 2);
+}
+
+BOOST_AUTO_TEST_CASE(exception_ptr) {
+    auto handle = [](std::exception_ptr const& ptr) {
+        return pexExcept::dispatch(
+                ptr, [](pexExcept::NotFoundError const& e) { return std::string(e.what()); },
+                [](pexExcept::RuntimeError const&) { return std::string("runtime"); });
+    };
+    BOOST_CHECK_EQUAL(handle(std::make_exception_ptr(LSST_EXCEPT(pexExcept::NotFoundError, "key"))), "key");
+    BOOST_CHECK_EQUAL(handle(std::make_exception_ptr(LSST_EXCEPT(pexExcept::IoError, ""))), "runtime");
+    // Exceptions that no handler takes propagate.
+    BOOST_CHECK_THROW(handle(std::make_exception_ptr(LSST_EXCEPT(pexExcept::LogicError, ""))),
+                      pexExcept::LogicError);
+    BOOST_CHECK_THROW(handle(std::make_exception_ptr(42)), int);
+    BOOST_CHECK_THROW(handle(std::exception_ptr()), pexExcept::InvalidParameterError);
+}
+
+BOOST_AUTO_TEST_CASE(threads) {
+    std::vector<std::thread> threads;
+    std::vector<int> failures(8);
+    for (int t = 0; t < 8; ++t) {
+        threads.emplace_back([&failures, t]() {
+            for (int i = 0; i < 1000; ++i) {
+                if (classify(LSST_EXCEPT(pexExcept::UnderflowError, "")) != "RuntimeError") ++failures[t];
+                if (classify(LSST_EXCEPT(pexExcept::DomainError, "")) != "LogicError") ++failures[t];
+            }
+        });
+    }
+    for (auto& thread : threads) thread.join();
+    for (int count : failures) BOOST_CHECK_EQUAL(count, 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -252,3 +252,108 @@ BOOST_AUTO_TEST_CASE(rethrow_twice) {
 }
 
 BOOST_AUTO_TEST_SUITE_END()
+
+// The line of the LSST_EXCEPT in f1 above.
+int const F1_LINE = 42;
+
+// LSST_EXCEPT may also be used in constexpr functions, default member initializers and default
+// arguments.
+int const CHECKED_POSITIVE_LINE = __LINE__ + 2;
+constexpr int checkedPositive(int value) {
+    if (value <= 0) throw LSST_EXCEPT(ChildException, "value is not positive");
+    return value;
+}
+
+static_assert(checkedPositive(1) == 1, "checkedPositive");
+
+struct Holder {
+    pexExcept::Exception error = LSST_EXCEPT(pexExcept::Exception, "In member initializer");
+};
+
+std::string describe(pexExcept::Exception const& error = LSST_EXCEPT(pexExcept::Exception,
+                                                                      "In default argument")) {
+    return error.what();
+}
+
+BOOST_AUTO_TEST_SUITE(SiteSuite)
+
+BOOST_AUTO_TEST_CASE(static_site) {
+    pexExcept::TracepointSite const* sites[2];
+    for (int i = 0; i != 2; ++i) {
+        try {
+            f1();
+        } catch (pexExcept::Exception const& e) {
+            sites[i] = e.getTraceback()[0]._site;
+        }
+    }
+    BOOST_CHECK_EQUAL(sites[0], sites[1]);
+    BOOST_CHECK_EQUAL(sizeof(pexExcept::Tracepoint), sizeof(sites[0]) + sizeof(std::string));
+    BOOST_CHECK_EQUAL(sites[0]->_line, F1_LINE);
+    BOOST_CHECK_EQUAL(sites[0]->_hash, pexExcept::TracepointSite::hashLocation(__FILE__, F1_LINE));
+}
+
+BOOST_AUTO_TEST_CASE(expression_contexts) {
+    BOOST_CHECK_EQUAL(checkedPositive(2), 2);
+    try {
+        checkedPositive(0);
+        BOOST_FAIL("Expected ChildException not thrown");
+    } catch (ChildException const& e) {
+        BOOST_REQUIRE_EQUAL(e.getTraceback().size(), 1u);
+        BOOST_CHECK_EQUAL(e.getTraceback()[0].getLine(), CHECKED_POSITIVE_LINE);
+        BOOST_CHECK(e.getTraceback()[0]._site->_type == &typeid(ChildException));
+    }
+    BOOST_CHECK_EQUAL(std::string(Holder().error.what()), "In member initializer");
+    BOOST_CHECK_EQUAL(describe(), "In default argument");
+}
+
+BOOST_AUTO_TEST_CASE(interned_site) {
+    std::string file = "dynamic.cc";
+    pexExcept::Exception e1(file.c_str(), 10, "void g()", "first");
+    pexExcept::Exception e2("dynamic.cc", 10, "void g()", "second");
+    file = "overwritten";
+    BOOST_CHECK_EQUAL(e1.getTraceback()[0]._site, e2.getTraceback()[0]._site);
+    BOOST_CHECK_EQUAL(e1.getTraceback()[0].getFile(), "dynamic.cc");
+    BOOST_CHECK_EQUAL(e1.getTraceback()[0].getLine(), 10);
+    BOOST_CHECK_EQUAL(e1.getTraceback()[0].getFunction(), "void g()");
+    BOOST_CHECK_EQUAL(e1.getTraceback()[0]._file(), "dynamic.cc");
+    BOOST_CHECK_EQUAL(e1.getTraceback()[0]._line(), 10);
+    BOOST_CHECK_EQUAL(e1.getTraceback()[0]._func(), "void g()");
+}
+
+BOOST_AUTO_TEST_CASE(copy_on_write) {
+    try {
+        f4();
+    } catch (pexExcept::Exception const& e) {
+        pexExcept::Exception copy(e);
+        BOOST_CHECK_EQUAL(copy.what(), e.what());  // same buffer while shared
+        LSST_EXCEPT_ADD(copy, "In copy");
+        BOOST_CHECK_EQUAL(std::string(e.what()), "In f1 {0}; In f4 {1}");
+        BOOST_CHECK_EQUAL(e.getTraceback().size(), 2u);
+        BOOST_CHECK_EQUAL(std::string(copy.what()), "In f1 {0}; In f4 {1}; In copy {2}");
+        BOOST_CHECK_EQUAL(copy.getTraceback().size(), 3u);
+        pexExcept::Exception moved(std::move(copy));
+        BOOST_CHECK_EQUAL(std::string(copy.what()), std::string(moved.what()));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(clone_with_data) {
+    DataException original = LSST_EXCEPT(DataException, "with data", 42);
+    BOOST_CHECK_EQUAL(original.getTraceback()[0].getLine(), __LINE__ - 1);  // subclass with LSST_EARGS_TYPED
+    std::unique_ptr<pexExcept::Exception> cloned(original.clone());
+    pexExcept::Exception& clonedRef = *cloned;
+    LSST_EXCEPT_ADD(clonedRef, "after clone");
+    DataException* data = dynamic_cast<DataException*>(cloned.get());
+    BOOST_REQUIRE(data);
+    BOOST_CHECK_EQUAL(data->getValue(), 42);
+    BOOST_CHECK_EQUAL(std::string(original.what()), "with data");
+    BOOST_CHECK_EQUAL(std::string(data->what()), "with data {0}; after clone {1}");
+}
+
+BOOST_AUTO_TEST_CASE(site_subclass) {
+    SiteDataException e = LSST_EXCEPT(SiteDataException, "with site", 7);
+    BOOST_CHECK_EQUAL(e.getValue(), 7);
+    BOOST_CHECK_EQUAL(e.getTraceback()[0].getLine(), __LINE__ - 2);
+    BOOST_CHECK(e.getTraceback()[0]._site->_type == &typeid(SiteDataException));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -30,4 +30,29 @@ namespace pexExcept = lsst::pex::exceptions;
 
 LSST_EXCEPTION_TYPE(ChildException, pexExcept::Exception, ChildException)
 
+// Exceptions with additional data, which must override clone(); the first takes its location as a file,
+// line and function, the second as a site.
+class DataException : public pexExcept::Exception {
+public:
+    DataException(LSST_EARGS_TYPED, int value) : pexExcept::Exception(LSST_EARGS_UNTYPED), _value(value) {}
+    int getValue() const { return _value; }
+    virtual char const* getType(void) const noexcept { return "DataException *"; }
+    virtual pexExcept::Exception* clone(void) const { return new DataException(*this); }
+
+private:
+    int _value;
+};
+
+class SiteDataException : public pexExcept::Exception {
+public:
+    SiteDataException(LSST_EARGS_SITE_TYPED, int value)
+            : pexExcept::Exception(LSST_EARGS_SITE_UNTYPED), _value(value) {}
+    int getValue() const { return _value; }
+    virtual char const* getType(void) const noexcept { return "SiteDataException *"; }
+    virtual pexExcept::Exception* clone(void) const { return new SiteDataException(*this); }
+
+private:
+    int _value;
+};
+
 #endif
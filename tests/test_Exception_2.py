@@ -19,6 +19,9 @@
 # You should have received a copy of the GNU General Public License
 # along with this program.  If not, see <https://www.gnu.org/licenses/>.
 
+import errno
+import os
+import traceback
 import unittest
 
 import lsst.pex.exceptions
@@ -128,6 +131,209 @@ class ExceptionTestCase(unittest.TestCase):
                              lsst.pex.exceptions.Exception,
                              TypeError])
 
+    def testErrno(self):
+        try:
+            testLib.failIoErrorErrno(errno.ENOENT, "/no/such.fits")
+        except FileNotFoundError:
+            self.fail("C++ IoError should not be translated to a specific OSError subclass")
+        except OSError as err:
+            self.assertIsInstance(err, lsst.pex.exceptions.IoError)
+            self.assertEqual(err.errno, errno.ENOENT)
+            self.assertEqual(err.strerror, os.strerror(errno.ENOENT))
+            self.assertEqual(err.filename, "/no/such.fits")
+            self.assertEqual(err.what(),
+                             "Failed to open file: %s: '/no/such.fits'" % os.strerror(errno.ENOENT))
+        else:
+            self.fail("Expected Exception not raised")
+
+    def testNoErrno(self):
+        try:
+            testLib.failIoError1("message")
+        except lsst.pex.exceptions.IoError as err:
+            self.assertIsNone(err.errno)
+            self.assertIsNone(err.filename)
+        else:
+            self.fail("Expected Exception not raised")
+
+    def testPythonRaiseErrno(self):
+        try:
+            raise lsst.pex.exceptions.IoError("Cannot write", errno.EACCES, "out.fits")
+        except OSError as err:
+            self.assertEqual(err.errno, errno.EACCES)
+            self.assertEqual(err.filename, "out.fits")
+            self.assertEqual(err.what(), "Cannot write: %s: 'out.fits'" % os.strerror(errno.EACCES))
+
+    def testCause(self):
+        try:
+            testLib.failWithCause("message1", "message2")
+        except lsst.pex.exceptions.RuntimeError as err:
+            self.assertEqual(err.what(), "message2")
+            self.assertIsInstance(err.__cause__, lsst.pex.exceptions.NotFoundError)
+            self.assertEqual(err.__cause__.what(), "message1")
+            self.assertNotIn("message1", str(err))
+        else:
+            self.fail("Expected Exception not raised")
+
+    def testTracebackFrames(self):
+        try:
+            testLib.failNotFoundError2("message1", "message2")
+        except lsst.pex.exceptions.NotFoundError as err:
+            before = str(err)
+            frames = traceback.extract_tb(err.__traceback__)
+            text = "".join(traceback.format_exception(type(err), err, err.__traceback__))
+            self.assertEqual(str(err), before)
+            self.assertEqual(str(err).count("testLib.cc"), 2)
+        self.assertEqual(frames[0].filename, __file__)
+        self.assertEqual(frames[0].name, "testTracebackFrames")
+        cppFrames = frames[-2:]
+        for frame in cppFrames:
+            self.assertEqual(os.path.basename(frame.filename), "testLib.cc")
+        self.assertIn("fail2", cppFrames[0].name)
+        self.assertIn("fail1", cppFrames[1].name)
+        self.assertGreater(cppFrames[0].lineno, cppFrames[1].lineno)
+        # The traceback shows each C++ site once, as a frame, and not again after the type.
+        self.assertEqual(text.count("testLib.cc"), 2)
+        self.assertTrue(text.endswith(": message1 {0}; message2 {1}\n"))
+
+        try:
+            testLib.failWithCause("message1", "message2")
+        except lsst.pex.exceptions.RuntimeError as err:
+            causeFrames = traceback.extract_tb(err.__cause__.__traceback__)
+        self.assertEqual(len(causeFrames), 1)
+        self.assertIn("fail1", causeFrames[0].name)
+
+        # Exceptions raised from Python have no C++ frames.
+        try:
+            raise lsst.pex.exceptions.NotFoundError("message")
+        except lsst.pex.exceptions.NotFoundError as err:
+            self.assertEqual(len(traceback.extract_tb(err.__traceback__)), 1)
+
+    def testLightweight(self):
+        with self.assertRaises(LookupError) as context:
+            testLib.failLight()
+        err = context.exception
+        self.assertIsInstance(err, lsst.pex.exceptions.NotFoundError)
+        self.assertTrue(err.isLightweight())
+        self.assertEqual(err.what(), "no such key")
+        self.assertIn("testLib.cc", str(err))
+        self.assertNotIn("testLib.cc", [frame.filename for frame in traceback.extract_tb(err.__traceback__)])
+
+        with self.assertRaises(lsst.pex.exceptions.NotFoundError) as context:
+            testLib.failLightAdded("while testing")
+        err = context.exception
+        self.assertFalse(err.isLightweight())
+        self.assertEqual(err.what(), "no such key {0}; while testing {1}")
+        self.assertEqual(len(err.getTraceback()), 2)
+
+    def testStringCache(self):
+        try:
+            testLib.failLogicError2("message1", "message2")
+        except lsst.pex.exceptions.LogicError as err:
+            text = str(err)
+            self.assertIs(str(err), text)
+            err.addMessage("file.cc", 1, "function", "message3")
+            self.assertIn("message3 {2}", str(err))
+            self.assertIsNot(str(err), text)
+        else:
+            self.fail("Expected Exception not raised")
+
+    def testFlightRecorder(self):
+        lsst.pex.exceptions.setFlightRecorderEnabled(True)
+        try:
+            testLib.failNotFoundError1("swallowed")
+        except lsst.pex.exceptions.NotFoundError:
+            pass
+        records = lsst.pex.exceptions.getRecentExceptions(1)
+        self.assertEqual(len(records), 1)
+        self.assertEqual(records[0].type, "lsst::pex::exceptions::NotFoundError")
+        self.assertEqual(records[0].message, "swallowed")
+        self.assertTrue(records[0].file.endswith("testLib.cc"))
+        self.assertGreater(records[0].line, 0)
+
+        lsst.pex.exceptions.setFlightRecorderEnabled(False)
+        self.assertFalse(lsst.pex.exceptions.isFlightRecorderEnabled())
+        try:
+            testLib.failNotFoundError1("ignored")
+        except lsst.pex.exceptions.NotFoundError:
+            pass
+        lsst.pex.exceptions.setFlightRecorderEnabled(True)
+        self.assertEqual(lsst.pex.exceptions.getRecentExceptions(1)[0].message, "swallowed")
+
+    def testMemory(self):
+        try:
+            testLib.failNotFoundError2("message1", "x" * 1000)
+        except lsst.pex.exceptions.NotFoundError as err:
+            self.assertGreater(err.memoryFootprint(), 2000)
+        if lsst.pex.exceptions.hasExceptionGauges():
+            count = lsst.pex.exceptions.getLiveExceptionCount()
+            nBytes = lsst.pex.exceptions.getLiveExceptionBytes()
+            errors = []
+            for i in range(10):
+                try:
+                    testLib.failNotFoundError1("y" * 1000)
+                except lsst.pex.exceptions.NotFoundError as err:
+                    errors.append(err)
+            self.assertEqual(lsst.pex.exceptions.getLiveExceptionCount(), count + 10)
+            self.assertGreater(lsst.pex.exceptions.getLiveExceptionBytes(), nBytes + 10 * 2000)
+            del errors
+            self.assertEqual(lsst.pex.exceptions.getLiveExceptionCount(), count)
+            self.assertEqual(lsst.pex.exceptions.getLiveExceptionBytes(), nBytes)
+
+    def testObserver(self):
+        events = []
+
+        def observer(exc, tracepoint, event):
+            events.append((type(exc), exc.what(), tracepoint._message, event))
+
+        observerId = lsst.pex.exceptions.addExceptionObserver(observer)
+        try:
+            testLib.failNotFoundError2("message1", "message2")
+        except lsst.pex.exceptions.NotFoundError:
+            pass
+        finally:
+            self.assertTrue(lsst.pex.exceptions.removeExceptionObserver(observerId))
+        Event = lsst.pex.exceptions.ExceptionEvent
+        self.assertEqual(len(events), 2)
+        self.assertEqual(events[0][0], lsst.pex.exceptions.NotFoundError)
+        self.assertEqual(events[0][1:], ("message1", "message1", Event.CONSTRUCTED))
+        self.assertEqual(events[1][0], lsst.pex.exceptions.NotFoundError)
+        self.assertEqual(events[1][1:], ("message1 {0}; message2 {1}", "message2", Event.MESSAGE_ADDED))
+
+        events.clear()
+        try:
+            testLib.failNotFoundError1("unobserved")
+        except lsst.pex.exceptions.NotFoundError:
+            pass
+        self.assertEqual(events, [])
+
+    def testFaultInjection(self):
+        def injected(n):
+            calls = []
+            for i in range(1, n + 1):
+                try:
+                    testLib.checkIndex(1, 10)
+                except lsst.pex.exceptions.OutOfRangeError as err:
+                    self.assertEqual(err.what(), "Injected fault")
+                    calls.append(i)
+            return calls
+
+        try:
+            self.assertEqual(injected(10), [])
+            lsst.pex.exceptions.setFaultRules("site=testLib.cc,type=OutOfRangeError,every=4")
+            self.assertEqual(injected(10), [4, 8])
+            self.assertEqual(lsst.pex.exceptions.getInjectedFaultCount(), 2)
+            lsst.pex.exceptions.setFaultRules("type=OutOfRangeError,probability=0.1,seed=5")
+            first = injected(1000)
+            lsst.pex.exceptions.setFaultRules("type=OutOfRangeError,probability=0.1,seed=5")
+            self.assertEqual(injected(1000), first)
+            self.assertGreater(len(first), 50)
+            self.assertLess(len(first), 150)
+            with self.assertRaises(lsst.pex.exceptions.InvalidParameterError):
+                lsst.pex.exceptions.setFaultRules("every=often")
+        finally:
+            lsst.pex.exceptions.clearFaultRules()
+        self.assertEqual(injected(10), [])
+
 
 if __name__ == '__main__':
     unittest.main()
@@ -0,0 +1,244 @@
+/*
+ * This file is part of pex_exceptions.
+ *
+ * Developed for the LSST Data Management System.
+ * This product includes software developed by the LSST Project
+ * (https://www.lsst.org).
+ * See the COPYRIGHT file at the top-level directory of this distribution
+ * for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <cerrno>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+
+#include "boost/format.hpp"
+
+#include "lsst/pex/exceptions/Gauges.h"
+#include "lsst/pex/exceptions/Runtime.h"
+
+#define BOOST_TEST_MODULE Exception_3
+#define BOOST_TEST_DYN_LINK
+#include "boost/test/unit_test.hpp"
+
+namespace pexExcept = lsst::pex::exceptions;
+
+namespace {
+
+// Return the file shown for a site on `line` of this file; in site ID mode, without a site map, only the
+// site's ID is known.
+std::string siteFile([[maybe_unused]] int line) {
+#if defined(LSST_EXCEPT_SITE_IDS)
+    return (boost::format("<site 0x%016x>") % pexExcept::TracepointSite::hashLocation(__FILE__, line)).str();
+#else
+    return __FILE__;
+#endif
+}
+
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(ExceptionSuite)
+
+BOOST_AUTO_TEST_CASE(error_code) {
+    errno = ENOENT;
+    pexExcept::IoError e = LSST_EXCEPT_ERRNO(pexExcept::IoError, "Failed to open file", "/no/such.fits");
+    BOOST_CHECK(e.getErrorCode() == std::errc::no_such_file_or_directory);
+    BOOST_CHECK_EQUAL(e.getErrorCode().value(), ENOENT);
+    BOOST_CHECK_EQUAL(e.getPath(), "/no/such.fits");
+    std::string const expected = "Failed to open file: " +
+                                 std::generic_category().message(ENOENT) + ": '/no/such.fits'";
+    BOOST_CHECK_EQUAL(e.what(), expected);
+    BOOST_CHECK_EQUAL(e.what(), e.what());  // formatted once
+
+    std::ostringstream stream;
+    stream << e;
+    BOOST_CHECK(stream.str().find("    " + expected + " {0}\n") != std::string::npos);
+    BOOST_CHECK(stream.str().find("lsst::pex::exceptions::IoError: '" + expected + "'\n") !=
+                std::string::npos);
+}
+
+BOOST_AUTO_TEST_CASE(error_code_add_message) {
+    pexExcept::IoError e = LSST_EXCEPT(pexExcept::IoError, "",
+                                       std::make_error_code(std::errc::permission_denied), "out.fits");
+    pexExcept::IoError copy(e);
+    LSST_EXCEPT_ADD(e, "while writing");
+    std::string const detail = std::generic_category().message(EACCES) + ": 'out.fits'";
+    BOOST_CHECK_EQUAL(e.what(), detail + " {0}; while writing {1}");
+    BOOST_CHECK_EQUAL(e.getTraceback()[0]._message, detail);
+    BOOST_CHECK_EQUAL(copy.what(), detail);
+    BOOST_CHECK(e.getErrorCode() == copy.getErrorCode());
+}
+
+BOOST_AUTO_TEST_CASE(no_error_code) {
+    pexExcept::NotFoundError e = LSST_EXCEPT(pexExcept::NotFoundError, "missing");
+    BOOST_CHECK(!e.getErrorCode());
+    BOOST_CHECK(e.getPath().empty());
+    BOOST_CHECK_EQUAL(e.what(), "missing");
+}
+
+void loadCalibration() { throw LSST_EXCEPT(pexExcept::NotFoundError, "no calibration"); }
+
+void processVisit() {
+    try {
+        loadCalibration();
+    } catch (pexExcept::NotFoundError const&) {
+        throw LSST_EXCEPT_FROM(pexExcept::RuntimeError, std::current_exception(), "visit failed");
+    }
+}
+
+BOOST_AUTO_TEST_CASE(cause) {
+    try {
+        processVisit();
+        BOOST_FAIL("Expected RuntimeError not thrown");
+    } catch (pexExcept::RuntimeError const& e) {
+        BOOST_CHECK_EQUAL(e.what(), "visit failed");
+        BOOST_REQUIRE(e.getCause());
+        try {
+            std::rethrow_exception(e.getCause());
+        } catch (pexExcept::NotFoundError const& cause) {
+            BOOST_CHECK_EQUAL(cause.what(), "no calibration");
+            BOOST_CHECK_EQUAL(cause.getTraceback().size(), 1u);
+        }
+        std::ostringstream stream;
+        stream << e;
+        std::string const text = stream.str();
+        std::size_t const outer = text.find("lsst::pex::exceptions::RuntimeError: 'visit failed'\n");
+        std::size_t const causedBy = text.find("Caused by:\n  File");
+        std::size_t const inner = text.find("lsst::pex::exceptions::NotFoundError: 'no calibration'\n");
+        BOOST_CHECK(outer < causedBy && causedBy < inner && inner != std::string::npos);
+        std::ostringstream own;
+        e.addTracebackToStream(own);
+        BOOST_CHECK(own.str().find("Caused by:") == std::string::npos);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(std_cause) {
+    pexExcept::RuntimeError e = LSST_EXCEPT_FROM(
+            pexExcept::RuntimeError, std::make_exception_ptr(std::out_of_range("bad index")), "wrapped");
+    pexExcept::RuntimeError copy(e);
+    BOOST_CHECK(copy.getCause() == e.getCause());  // shared, not copied
+    std::ostringstream stream;
+    stream << e;
+    BOOST_CHECK(stream.str().find("Caused by: bad index\n") != std::string::npos);
+}
+
+BOOST_AUTO_TEST_CASE(self_cause) {
+    std::exception_ptr const current = std::make_exception_ptr(LSST_EXCEPT(pexExcept::RuntimeError, "loop"));
+    try {
+        std::rethrow_exception(current);
+    } catch (pexExcept::RuntimeError& e) {
+        e.setCause(current);  // e is the exception held by current
+        std::ostringstream stream;
+        stream << e;
+        std::string const text = stream.str();
+        std::size_t causes = 0;
+        for (std::size_t i = text.find("Caused by:"); i != std::string::npos;
+             i = text.find("Caused by:", i + 1)) {
+            ++causes;
+        }
+        BOOST_CHECK_EQUAL(causes, 17u);
+        BOOST_CHECK(text.find("Caused by: ... (further causes not shown)\n") != std::string::npos);
+        e.setCause(nullptr);  // break the reference cycle
+    }
+}
+
+BOOST_AUTO_TEST_CASE(lightweight) {
+    std::size_t const live = pexExcept::getLiveExceptionCount();
+    int const line = __LINE__ + 2;
+    try {
+        throw LSST_EXCEPT_LIGHT(pexExcept::NotFoundError, "no such key");
+    } catch (pexExcept::NotFoundError const& e) {
+        BOOST_CHECK(e.isLightweight());
+        BOOST_CHECK_EQUAL(e.what(), "no such key");
+        BOOST_CHECK(e.getTraceback().empty());
+        BOOST_CHECK(!e.getCause());
+        BOOST_CHECK(!e.getErrorCode());
+        BOOST_CHECK_EQUAL(e.memoryFootprint(), sizeof(pexExcept::NotFoundError));
+        BOOST_CHECK_EQUAL(pexExcept::getLiveExceptionCount(), live);  // nothing allocated
+        std::ostringstream stream;
+        stream << e;
+        std::string const location = siteFile(line) + "\", line " + std::to_string(line);
+        BOOST_CHECK(stream.str().find(location) != std::string::npos);
+        BOOST_CHECK(stream.str().find("    no such key {0}\n"
+                                      "lsst::pex::exceptions::NotFoundError: 'no such key'\n") !=
+                    std::string::npos);
+
+        pexExcept::NotFoundError copy(e);
+        BOOST_CHECK(copy.isLightweight());
+        BOOST_CHECK_EQUAL(copy.what(), e.what());
+    }
+}
+
+BOOST_AUTO_TEST_CASE(lightweight_upgrade) {
+    pexExcept::NotFoundError e = LSST_EXCEPT_LIGHT(pexExcept::NotFoundError, "no such key");
+    pexExcept::NotFoundError copy(e);
+    int const line = __LINE__ + 1;
+    LSST_EXCEPT_ADD(e, "while reading the catalog");
+    BOOST_CHECK(!e.isLightweight());
+    BOOST_CHECK_EQUAL(e.what(), "no such key {0}; while reading the catalog {1}");
+    BOOST_REQUIRE_EQUAL(e.getTraceback().size(), 2u);
+    BOOST_CHECK_EQUAL(e.getTraceback()[0]._message, "no such key");
+    BOOST_CHECK_EQUAL(e.getTraceback()[1].getLine(), line);
+    BOOST_CHECK(copy.isLightweight());  // copies are not affected
+
+    copy = e;
+    BOOST_CHECK(!copy.isLightweight());
+    copy = LSST_EXCEPT_LIGHT(pexExcept::NotFoundError, "another key");
+    BOOST_CHECK_EQUAL(copy.what(), "another key");
+
+    pexExcept::RuntimeError withCause = LSST_EXCEPT_LIGHT(pexExcept::RuntimeError, "failed");
+    withCause.setCause(std::make_exception_ptr(copy));
+    BOOST_CHECK(!withCause.isLightweight());
+    BOOST_CHECK_EQUAL(withCause.getTraceback().size(), 1u);
+}
+
+BOOST_AUTO_TEST_CASE(as_string) {
+    pexExcept::NotFoundError e = LSST_EXCEPT(pexExcept::NotFoundError, "no such key");
+    std::string const text = e.asString();
+    std::ostringstream stream;
+    e.addTracebackToStream(stream);
+    BOOST_CHECK_EQUAL(text, stream.str());
+    BOOST_CHECK(text.find("    no such key {0}\nlsst::pex::exceptions::NotFoundError: 'no such key'\n") !=
+                std::string::npos);
+    BOOST_CHECK_EQUAL(e.asString(), text);
+
+    // Adding a message discards the cached text, without affecting copies.
+    pexExcept::NotFoundError copy(e);
+    LSST_EXCEPT_ADD(e, "while reading the catalog");
+    BOOST_CHECK(e.asString().find("    while reading the catalog {1}\n") != std::string::npos);
+    BOOST_CHECK_EQUAL(copy.asString(), text);
+
+    // A sliced copy shares the payload, but not the type.
+    pexExcept::Exception sliced(copy);
+    BOOST_CHECK(sliced.asString().find("lsst::pex::exceptions::Exception: 'no such key'\n") !=
+                std::string::npos);
+    BOOST_CHECK_EQUAL(copy.asString(), text);
+
+    // The cached text is included in the footprint.
+    pexExcept::RuntimeError fresh = LSST_EXCEPT(pexExcept::RuntimeError, "failed");
+    std::size_t const footprint = fresh.memoryFootprint();
+    fresh.asString();
+    BOOST_CHECK_GT(fresh.memoryFootprint(), footprint);
+
+    pexExcept::NotFoundError light = LSST_EXCEPT_LIGHT(pexExcept::NotFoundError, "no such key");
+    std::ostringstream lightStream;
+    light.addTracebackToStream(lightStream);
+    BOOST_CHECK_EQUAL(light.asString(), lightStream.str());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,203 @@
+/*
+ * This file is part of pex_exceptions.
+ *
+ * Developed for the LSST Data Management System.
+ * This product includes software developed by the LSST Project
+ * (https://www.lsst.org).
+ * See the COPYRIGHT file at the top-level directory of this distribution
+ * for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "boost/format.hpp"
+
+#include "lsst/pex/exceptions/SiteMap.h"
+#include "lsst/pex/exceptions/asserts.h"
+
+#define BOOST_TEST_MODULE FaultInjection
+#define BOOST_TEST_DYN_LINK
+#include "boost/test/unit_test.hpp"
+
+namespace pexExcept = lsst::pex::exceptions;
+
+namespace {
+
+int const CHECK_LINE = __LINE__ + 3;  // the line of the LSST_CHECK_INDEX below
+
+void checkIndex(int i) {
+    LSST_CHECK_INDEX(i, 10);
+}
+
+
+// Return the calls, out of `n`, at which `func` threw an injected fault.
+template <typename F>
+std::vector<int> injectedCalls(F func, int n) {
+    std::vector<int> calls;
+    for (int i = 1; i <= n; ++i) {
+        try {
+            func();
+        } catch (pexExcept::Exception const& e) {
+            BOOST_CHECK_EQUAL(e.what(), "Injected fault");
+            calls.push_back(i);
+        }
+    }
+    return calls;
+}
+
+#ifndef LSST_EXCEPT_NO_FAULT_INJECTION
+void checkLength(int n) { LSST_THROW_IF_NE(n, 3, pexExcept::LengthError, "Length %d is not %d"); }
+
+// In site ID mode sites only have a path once their site map is loaded; load one for checkIndex.
+void loadCheckSiteMap() {
+#if defined(LSST_EXCEPT_SITE_IDS)
+    std::string const path = "test_FaultInjection.sites.tmp";
+    std::ofstream(path) << boost::format("%016x\t%d\t%s\tcheckIndex\n") %
+                                   pexExcept::TracepointSite::hashLocation(__FILE__, CHECK_LINE) %
+                                   CHECK_LINE % __FILE__;
+    pexExcept::loadSiteMap(path);
+    std::remove(path.c_str());
+#endif
+}
+#endif
+
+struct ClearRules {
+    ~ClearRules() { pexExcept::clearFaultRules(); }
+};
+
+}  // namespace
+
+BOOST_FIXTURE_TEST_SUITE(FaultInjectionSuite, ClearRules)
+
+BOOST_AUTO_TEST_CASE(disabled) {
+    BOOST_CHECK(!pexExcept::detail::faultInjectionEnabled.load());
+    BOOST_CHECK(injectedCalls([]() { checkIndex(1); }, 100).empty());
+    BOOST_CHECK_THROW(checkIndex(10), pexExcept::OutOfRangeError);
+}
+
+#ifndef LSST_EXCEPT_NO_FAULT_INJECTION
+
+BOOST_AUTO_TEST_CASE(every_nth_call_at_site) {
+    loadCheckSiteMap();
+    pexExcept::setFaultRules("site=test_FaultInjection.cc:" + std::to_string(CHECK_LINE) + ",every=3");
+    BOOST_CHECK(pexExcept::detail::faultInjectionEnabled.load());
+    BOOST_CHECK(injectedCalls([]() { checkIndex(1); }, 10) == (std::vector<int>{3, 6, 9}));
+    BOOST_CHECK(injectedCalls([]() { checkLength(3); }, 10).empty());
+    BOOST_CHECK_EQUAL(pexExcept::getInjectedFaultCount(), 3u);
+    try {
+        checkIndex(1);
+        checkIndex(1);
+        checkIndex(1);
+        BOOST_FAIL("Expected an injected fault");
+    } catch (pexExcept::OutOfRangeError const& e) {  // thrown as the type the check would throw
+        BOOST_CHECK_EQUAL(e.getTraceback().front().getLine(), CHECK_LINE);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(by_type) {
+    pexExcept::setFaultRules("type=LengthError");
+    BOOST_CHECK(injectedCalls([]() { checkIndex(1); }, 5).empty());
+    BOOST_CHECK_EQUAL(injectedCalls([]() { checkLength(3); }, 5).size(), 5u);
+    pexExcept::setFaultRules("type=lsst::pex::exceptions::OutOfRangeError");
+    BOOST_CHECK_EQUAL(injectedCalls([]() { checkIndex(1); }, 5).size(), 5u);
+    BOOST_CHECK(injectedCalls([]() { checkLength(3); }, 5).empty());
+    pexExcept::setFaultRules("type=RangeError");  // not a prefix or suffix match
+    BOOST_CHECK(injectedCalls([]() { checkIndex(1); }, 5).empty());
+}
+
+BOOST_AUTO_TEST_CASE(by_fingerprint) {
+    pexExcept::FaultRule rule;
+    rule.fingerprint = pexExcept::TracepointSite::hashLocation(__FILE__, CHECK_LINE);
+    pexExcept::setFaultRules(std::vector<pexExcept::FaultRule>{rule});
+    BOOST_CHECK_EQUAL(injectedCalls([]() { checkIndex(1); }, 5).size(), 5u);
+    BOOST_CHECK(injectedCalls([]() { checkLength(3); }, 5).empty());
+}
+
+BOOST_AUTO_TEST_CASE(seeded_probability) {
+    std::string const spec = "type=OutOfRangeError,probability=0.05,seed=42";
+    pexExcept::setFaultRules(spec);
+    std::vector<int> const first = injectedCalls([]() { checkIndex(1); }, 10000);
+    pexExcept::setFaultRules(spec);
+    std::vector<int> const second = injectedCalls([]() { checkIndex(1); }, 10000);
+    BOOST_CHECK(first == second);
+    BOOST_CHECK(first.size() > 400 && first.size() < 600);
+    pexExcept::setFaultRules("type=OutOfRangeError,probability=0.05,seed=43");
+    BOOST_CHECK(injectedCalls([]() { checkIndex(1); }, 10000) != first);
+}
+
+BOOST_AUTO_TEST_CASE(inject_fault_macro) {
+    pexExcept::setFaultRules("type=IoError,every=2");
+    auto read = []() { LSST_INJECT_FAULT(pexExcept::IoError); };
+    BOOST_CHECK(injectedCalls(read, 4) == (std::vector<int>{2, 4}));
+}
+
+BOOST_AUTO_TEST_CASE(replace_while_checking) {
+    std::atomic<bool> stop(false);
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 4; ++i) {
+        threads.emplace_back([&stop]() {
+            while (!stop.load()) injectedCalls([]() { checkIndex(1); }, 100);
+        });
+    }
+    for (int i = 0; i < 1000; ++i) {
+        pexExcept::setFaultRules("type=OutOfRangeError,every=" + std::to_string(i % 7 + 1));
+    }
+    stop = true;
+    for (auto& thread : threads) thread.join();
+}
+
+#else
+
+BOOST_AUTO_TEST_CASE(compiled_out) {
+    pexExcept::setFaultRules("every=1");
+    BOOST_CHECK(injectedCalls([]() { checkIndex(1); }, 10).empty());
+    BOOST_CHECK(injectedCalls([]() { LSST_INJECT_FAULT(pexExcept::IoError); }, 10).empty());
+    BOOST_CHECK_EQUAL(pexExcept::getInjectedFaultCount(), 0u);
+}
+
+#endif
+
+BOOST_AUTO_TEST_CASE(parse_errors) {
+    BOOST_CHECK_THROW(pexExcept::parseFaultRules("bogus=1"), pexExcept::InvalidParameterError);
+    BOOST_CHECK_THROW(pexExcept::parseFaultRules("every"), pexExcept::InvalidParameterError);
+    BOOST_CHECK_THROW(pexExcept::parseFaultRules("every=x"), pexExcept::InvalidParameterError);
+    BOOST_CHECK_THROW(pexExcept::parseFaultRules("probability=-1"), pexExcept::InvalidParameterError);
+    // Rules that could never match are rejected when parsed or set, and the old rules kept.
+    BOOST_CHECK_THROW(pexExcept::parseFaultRules("type=std::vector<int>"), pexExcept::InvalidParameterError);
+    pexExcept::FaultRule unmatchable;
+    unmatchable.file = "<site 0x10>";
+    pexExcept::setFaultRules("every=1");
+    BOOST_CHECK_THROW(pexExcept::setFaultRules({unmatchable}), pexExcept::InvalidParameterError);
+    BOOST_CHECK(pexExcept::detail::faultInjectionEnabled.load());
+    BOOST_CHECK_EQUAL(pexExcept::parseFaultRules("site=<site 0x00000000000000ff>")[0].fingerprint, 255u);
+    std::vector<pexExcept::FaultRule> rules =
+            pexExcept::parseFaultRules("site=a/Fit.cc:12,every=5;fingerprint=0x10,probability=0.5,seed=7;");
+    BOOST_REQUIRE_EQUAL(rules.size(), 2u);
+    BOOST_CHECK_EQUAL(rules[0].file, "a/Fit.cc");
+    BOOST_CHECK_EQUAL(rules[0].line, 12);
+    BOOST_CHECK_EQUAL(rules[0].every, 5u);
+    BOOST_CHECK_EQUAL(rules[1].fingerprint, 16u);
+    BOOST_CHECK_EQUAL(rules[1].probability, 0.5);
+    BOOST_CHECK_EQUAL(rules[1].seed, 7u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,176 @@
+/*
+ * This file is part of pex_exceptions.
+ *
+ * Developed for the LSST Data Management System.
+ * This product includes software developed by the LSST Project
+ * (https://www.lsst.org).
+ * See the COPYRIGHT file at the top-level directory of this distribution
+ * for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <csignal>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "boost/format.hpp"
+
+#include "lsst/pex/exceptions/FlightRecorder.h"
+#include "lsst/pex/exceptions/Runtime.h"
+
+#define BOOST_TEST_MODULE FlightRecorder
+#define BOOST_TEST_DYN_LINK
+#include "boost/test/unit_test.hpp"
+
+namespace pexExcept = lsst::pex::exceptions;
+
+namespace {
+
+// Return the file shown for a site on `line` of this file; in site ID mode, without a site map, only the
+// site's ID is known.
+std::string siteFile([[maybe_unused]] int line) {
+#if defined(LSST_EXCEPT_SITE_IDS)
+    return (boost::format("<site 0x%016x>") % pexExcept::TracepointSite::hashLocation(__FILE__, line)).str();
+#else
+    return __FILE__;
+#endif
+}
+
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(FlightRecorderSuite)
+
+BOOST_AUTO_TEST_CASE(records_discarded_exceptions) {
+    pexExcept::setFlightRecorderEnabled(true);
+    int const line = __LINE__ + 2;
+    try {
+        throw LSST_EXCEPT(pexExcept::NotFoundError, "no such key");
+    } catch (pexExcept::NotFoundError const&) {
+    }
+    std::vector<pexExcept::ExceptionRecord> records = pexExcept::getRecentExceptions(1);
+    BOOST_REQUIRE_EQUAL(records.size(), 1u);
+    BOOST_CHECK_EQUAL(records[0].type, "lsst::pex::exceptions::NotFoundError");
+    BOOST_CHECK_EQUAL(records[0].file, siteFile(line));
+    BOOST_CHECK_EQUAL(records[0].line, line);
+#ifndef LSST_EXCEPT_SITE_IDS
+    BOOST_CHECK(records[0].function.find("test_method") != std::string::npos);
+#endif
+    BOOST_CHECK_EQUAL(records[0].message, "no such key");
+    BOOST_CHECK(records[0].timestamp > 0);
+}
+
+BOOST_AUTO_TEST_CASE(unknown_location) {
+    pexExcept::setFlightRecorderEnabled(true);
+    pexExcept::RuntimeError e("no location");
+    std::vector<pexExcept::ExceptionRecord> records = pexExcept::getRecentExceptions(1);
+    BOOST_REQUIRE_EQUAL(records.size(), 1u);
+    BOOST_CHECK_EQUAL(records[0].type, "");
+    BOOST_CHECK_EQUAL(records[0].file, "");
+    BOOST_CHECK_EQUAL(records[0].line, 0);
+    BOOST_CHECK_EQUAL(records[0].message, "no location");
+}
+
+BOOST_AUTO_TEST_CASE(order_and_capacity) {
+    pexExcept::setFlightRecorderEnabled(true);
+    std::size_t const total = pexExcept::FLIGHT_RECORDER_CAPACITY + 10;
+    for (std::size_t i = 0; i != total; ++i) {
+        LSST_EXCEPT(pexExcept::RuntimeError, std::to_string(i));
+    }
+    std::vector<pexExcept::ExceptionRecord> records = pexExcept::getRecentExceptions();
+    BOOST_REQUIRE_EQUAL(records.size(), pexExcept::FLIGHT_RECORDER_CAPACITY);
+    BOOST_CHECK_EQUAL(records.front().message, std::to_string(total - pexExcept::FLIGHT_RECORDER_CAPACITY));
+    BOOST_CHECK_EQUAL(records.back().message, std::to_string(total - 1));
+    BOOST_CHECK(records.front().timestamp <= records.back().timestamp);
+}
+
+BOOST_AUTO_TEST_CASE(truncated_message) {
+    pexExcept::setFlightRecorderEnabled(true);
+    std::string const message(200, 'x');
+    pexExcept::LogicError e = LSST_EXCEPT(pexExcept::LogicError, message);
+    BOOST_CHECK_EQUAL(e.what(), message);
+    std::vector<pexExcept::ExceptionRecord> records = pexExcept::getRecentExceptions(1);
+    BOOST_REQUIRE_EQUAL(records.size(), 1u);
+    BOOST_CHECK_EQUAL(records[0].message, message.substr(0, pexExcept::FLIGHT_RECORDER_MESSAGE_LENGTH));
+}
+
+BOOST_AUTO_TEST_CASE(disabled) {
+    pexExcept::setFlightRecorderEnabled(true);
+    LSST_EXCEPT(pexExcept::RuntimeError, "before");
+    pexExcept::setFlightRecorderEnabled(false);
+    BOOST_CHECK(!pexExcept::isFlightRecorderEnabled());
+    LSST_EXCEPT(pexExcept::RuntimeError, "while disabled");
+    pexExcept::setFlightRecorderEnabled(true);
+    std::vector<pexExcept::ExceptionRecord> records = pexExcept::getRecentExceptions(1);
+    BOOST_REQUIRE_EQUAL(records.size(), 1u);
+    BOOST_CHECK_EQUAL(records[0].message, "before");
+}
+
+BOOST_AUTO_TEST_CASE(dump) {
+    pexExcept::setFlightRecorderEnabled(true);
+    int const line = __LINE__ + 1;
+    LSST_EXCEPT(pexExcept::TypeError, "first");
+    LSST_EXCEPT(pexExcept::DomainError, "second");
+    int fds[2];
+    BOOST_REQUIRE_EQUAL(pipe(fds), 0);
+    pexExcept::dumpRecentExceptions(fds[1], 2);
+    close(fds[1]);
+    std::string text;
+    char buffer[256];
+    for (ssize_t n; (n = read(fds[0], buffer, sizeof(buffer))) > 0;) text.append(buffer, n);
+    close(fds[0]);
+    std::size_t const first = text.find("at " + siteFile(line) + ":" + std::to_string(line));
+    std::size_t const firstMessage = text.find(": first\n");
+    std::size_t const secondMessage = text.find(": second\n");
+    BOOST_CHECK(first != std::string::npos);
+    BOOST_CHECK(firstMessage < secondMessage && secondMessage != std::string::npos);
+    BOOST_CHECK(text.find("DomainError") != std::string::npos);
+    BOOST_CHECK_EQUAL(text[0], '[');
+}
+
+BOOST_AUTO_TEST_CASE(signal_handlers_installed_twice) {
+    int fds[2];
+    BOOST_REQUIRE_EQUAL(pipe(fds), 0);
+    pid_t pid = fork();
+    BOOST_REQUIRE(pid >= 0);
+    if (pid == 0) {
+        close(fds[0]);
+        dup2(fds[1], STDERR_FILENO);
+        std::signal(SIGABRT, SIG_DFL);  // rather than Boost.Test's handler
+        alarm(10);                      // in case the handler calls itself forever
+        pexExcept::installFlightRecorderSignalHandlers();
+        pexExcept::installFlightRecorderSignalHandlers();
+        pexExcept::setFlightRecorderEnabled(true);
+        LSST_EXCEPT(pexExcept::RuntimeError, "before abort");
+        std::abort();
+    }
+    close(fds[1]);
+    std::string text;
+    char buffer[256];
+    for (ssize_t n; (n = read(fds[0], buffer, sizeof(buffer))) > 0;) text.append(buffer, n);
+    close(fds[0]);
+    int status = 0;
+    waitpid(pid, &status, 0);
+    BOOST_CHECK(WIFSIGNALED(status) && WTERMSIG(status) == SIGABRT);
+    std::string const header = "Recently created LSST exceptions (oldest first):\n";
+    BOOST_CHECK_EQUAL(text.find(header), 0u);
+    BOOST_CHECK_EQUAL(text.find(header, 1), std::string::npos);
+    BOOST_CHECK(text.find(": before abort\n") != std::string::npos);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,96 @@
+/*
+ * This file is part of pex_exceptions.
+ *
+ * Developed for the LSST Data Management System.
+ * This product includes software developed by the LSST Project
+ * (https://www.lsst.org).
+ * See the COPYRIGHT file at the top-level directory of this distribution
+ * for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <exception>
+#include <string>
+
+#include "lsst/pex/exceptions/Gauges.h"
+#include "lsst/pex/exceptions/Runtime.h"
+
+#define BOOST_TEST_MODULE Gauges
+#define BOOST_TEST_DYN_LINK
+#include "boost/test/unit_test.hpp"
+
+namespace pexExcept = lsst::pex::exceptions;
+
+BOOST_AUTO_TEST_SUITE(GaugesSuite)
+
+BOOST_AUTO_TEST_CASE(footprint) {
+    pexExcept::NotFoundError e = LSST_EXCEPT(pexExcept::NotFoundError, "short");
+    std::size_t const initial = e.memoryFootprint();
+    BOOST_CHECK_GT(initial, sizeof(pexExcept::NotFoundError));
+
+    std::string const longMessage(1000, 'x');
+    LSST_EXCEPT_ADD(e, longMessage);
+    std::size_t const added = e.memoryFootprint();
+    // The new tracepoint's message, and the combined message, each hold a copy.
+    BOOST_CHECK_GE(added, initial + 2 * longMessage.size());
+
+    pexExcept::NotFoundError copy(e);
+    BOOST_CHECK_EQUAL(copy.memoryFootprint(), added);
+}
+
+BOOST_AUTO_TEST_CASE(gauges) {
+    if (!pexExcept::hasExceptionGauges()) {
+        BOOST_CHECK_EQUAL(pexExcept::getLiveExceptionCount(), 0u);
+        return;
+    }
+    std::size_t const count = pexExcept::getLiveExceptionCount();
+    std::size_t const bytes = pexExcept::getLiveExceptionBytes();
+    {
+        pexExcept::RuntimeError e = LSST_EXCEPT(pexExcept::RuntimeError, std::string(500, 'x'));
+        BOOST_CHECK_EQUAL(pexExcept::getLiveExceptionCount(), count + 1);
+        std::size_t const oneBytes = pexExcept::getLiveExceptionBytes() - bytes;
+        BOOST_CHECK_GE(oneBytes, 1000u);  // message and tracepoint message
+        BOOST_CHECK_LT(oneBytes, e.memoryFootprint());
+
+        // Copies share their message and traceback until modified.
+        pexExcept::RuntimeError copy(e);
+        BOOST_CHECK_EQUAL(pexExcept::getLiveExceptionCount(), count + 1);
+        BOOST_CHECK_EQUAL(pexExcept::getLiveExceptionBytes(), bytes + oneBytes);
+        LSST_EXCEPT_ADD(copy, "more");
+        BOOST_CHECK_EQUAL(pexExcept::getLiveExceptionCount(), count + 2);
+        BOOST_CHECK_GT(pexExcept::getLiveExceptionBytes(), bytes + 2 * oneBytes);
+
+        // Deferred text is counted once formatted.
+        pexExcept::IoError io = LSST_EXCEPT_ERRNO(pexExcept::IoError, std::string(500, 'y'), "file");
+        std::size_t const before = pexExcept::getLiveExceptionBytes();
+        io.what();
+        BOOST_CHECK_GT(pexExcept::getLiveExceptionBytes(), before + 500);
+    }
+    BOOST_CHECK_EQUAL(pexExcept::getLiveExceptionCount(), count);
+    BOOST_CHECK_EQUAL(pexExcept::getLiveExceptionBytes(), bytes);
+
+    std::exception_ptr stored;
+    try {
+        throw LSST_EXCEPT(pexExcept::RuntimeError, "stored");
+    } catch (...) {
+        stored = std::current_exception();
+    }
+    BOOST_CHECK_EQUAL(pexExcept::getLiveExceptionCount(), count + 1);
+    stored = nullptr;
+    BOOST_CHECK_EQUAL(pexExcept::getLiveExceptionCount(), count);
+    BOOST_CHECK_EQUAL(pexExcept::getLiveExceptionBytes(), bytes);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,224 @@
+/*
+ * This file is part of pex_exceptions.
+ *
+ * Developed for the LSST Data Management System.
+ * This product includes software developed by the LSST Project
+ * (https://www.lsst.org).
+ * See the COPYRIGHT file at the top-level directory of this distribution
+ * for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <atomic>
+#include <cerrno>
+#include <string>
+#include <thread>
+#include <typeinfo>
+#include <vector>
+
+#include "boost/format.hpp"
+
+#include "lsst/pex/exceptions/Observer.h"
+#include "lsst/pex/exceptions/asserts.h"
+#include "lsst/pex/exceptions/Runtime.h"
+
+#define BOOST_TEST_MODULE Observer
+#define BOOST_TEST_DYN_LINK
+#include "boost/test/unit_test.hpp"
+
+namespace pexExcept = lsst::pex::exceptions;
+
+namespace {
+
+struct Event {
+    pexExcept::ExceptionEvent event;
+    std::type_info const* type;
+    bool isNotFound;  // whether the exception itself is (so far) a NotFoundError
+    std::string file;
+    int line;
+    std::string message;
+    std::size_t tracebackSize;
+};
+
+// Return the file shown for a site on `line` of this file; in site ID mode, without a site map, only the
+// site's ID is known.
+std::string siteFile([[maybe_unused]] int line) {
+#if defined(LSST_EXCEPT_SITE_IDS)
+    return (boost::format("<site 0x%016x>") % pexExcept::TracepointSite::hashLocation(__FILE__, line)).str();
+#else
+    return __FILE__;
+#endif
+}
+
+// A subclass written against the file, line and function constructor arguments.
+class LegacyError : public pexExcept::RuntimeError {
+public:
+    LegacyError(LSST_EARGS_TYPED) : pexExcept::RuntimeError(LSST_EARGS_UNTYPED) {}
+    virtual char const* getType(void) const noexcept { return "LegacyError *"; }
+    virtual pexExcept::Exception* clone(void) const { return new LegacyError(*this); }
+};
+
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(ObserverSuite)
+
+BOOST_AUTO_TEST_CASE(construct_and_add) {
+    std::vector<Event> events;
+    std::size_t id = pexExcept::addExceptionObserver(
+            [&events](pexExcept::Exception const& e, pexExcept::Tracepoint const& tp,
+                      pexExcept::ExceptionEvent event) {
+                events.push_back(Event{event, tp._site->_type,
+                                       dynamic_cast<pexExcept::NotFoundError const*>(&e) != nullptr,
+                                       tp.getFile(), tp.getLine(), tp._message,
+                                       e.getTraceback().size()});
+            });
+    int const line = __LINE__ + 1;
+    pexExcept::NotFoundError e = LSST_EXCEPT(pexExcept::NotFoundError, "first");
+    LSST_EXCEPT_ADD(e, "second");
+    BOOST_CHECK(pexExcept::removeExceptionObserver(id));
+    LSST_EXCEPT_ADD(e, "unobserved");
+
+    BOOST_REQUIRE_EQUAL(events.size(), 2u);
+    BOOST_CHECK(events[0].event == pexExcept::ExceptionEvent::CONSTRUCTED);
+    BOOST_CHECK(events[0].type == &typeid(pexExcept::NotFoundError));
+    BOOST_CHECK(!events[0].isNotFound);  // reported from the Exception constructor
+    BOOST_CHECK_EQUAL(events[0].file, siteFile(line));
+    BOOST_CHECK_EQUAL(events[0].line, line);
+    BOOST_CHECK_EQUAL(events[0].message, "first");
+    BOOST_CHECK_EQUAL(events[0].tracebackSize, 1u);
+    BOOST_CHECK(events[1].event == pexExcept::ExceptionEvent::MESSAGE_ADDED);
+    BOOST_CHECK_EQUAL(events[1].line, line + 1);
+    BOOST_CHECK_EQUAL(events[1].message, "second");
+    BOOST_CHECK_EQUAL(events[1].tracebackSize, 2u);
+    BOOST_CHECK(events[1].isNotFound);
+}
+
+BOOST_AUTO_TEST_CASE(construction_paths) {
+    std::vector<Event> events;
+    std::size_t id = pexExcept::addExceptionObserver(
+            [&events](pexExcept::Exception const& e, pexExcept::Tracepoint const& tp,
+                      pexExcept::ExceptionEvent event) {
+                events.push_back(Event{event, tp._site->_type,
+                                       dynamic_cast<pexExcept::NotFoundError const*>(&e) != nullptr,
+                                       tp.getFile(), tp.getLine(), tp._message,
+                                       e.getTraceback().size()});
+            });
+    auto const constructed = [&events](std::string const& message) {
+        return events.size() == 1 && events[0].event == pexExcept::ExceptionEvent::CONSTRUCTED &&
+               events[0].message == message;
+    };
+
+    pexExcept::NotFoundError viaMacro = LSST_EXCEPT(pexExcept::NotFoundError, "macro");
+    BOOST_CHECK(constructed("macro"));
+    BOOST_CHECK(events[0].type == &typeid(pexExcept::NotFoundError));
+    events.clear();
+
+    pexExcept::NotFoundError direct(LSST_EXCEPT_HERE, "direct");
+    BOOST_CHECK(constructed("direct"));
+    BOOST_CHECK(events[0].type == nullptr);
+    events.clear();
+
+    pexExcept::NotFoundError legacy("legacy.cc", 12, "void legacy()", "legacy");
+    BOOST_CHECK(constructed("legacy"));
+    BOOST_CHECK_EQUAL(events[0].file, "legacy.cc");
+    BOOST_CHECK_EQUAL(events[0].line, 12);
+    events.clear();
+
+    LegacyError viaMacroLegacy = LSST_EXCEPT(LegacyError, "legacy subclass");
+    BOOST_CHECK(constructed("legacy subclass"));
+    events.clear();
+
+    errno = ENOENT;
+    pexExcept::IoError viaErrno = LSST_EXCEPT_ERRNO(pexExcept::IoError, "errno", "missing.fits");
+    BOOST_CHECK(constructed("errno"));
+    events.clear();
+
+    pexExcept::RuntimeError viaFrom = LSST_EXCEPT_FROM(pexExcept::RuntimeError, nullptr, "from");
+    BOOST_CHECK(constructed("from"));
+    events.clear();
+
+    pexExcept::NotFoundError messageOnly("message only");  // as from Python; no tracepoint
+    pexExcept::NotFoundError light = LSST_EXCEPT_LIGHT(pexExcept::NotFoundError, "light");
+    pexExcept::NotFoundError copy(viaMacro);
+    BOOST_CHECK(events.empty());
+
+    LSST_EXCEPT_ADD(light, "upgraded");
+    BOOST_CHECK(pexExcept::removeExceptionObserver(id));
+    BOOST_REQUIRE_EQUAL(events.size(), 1u);
+    BOOST_CHECK(events[0].event == pexExcept::ExceptionEvent::MESSAGE_ADDED);
+    BOOST_CHECK_EQUAL(events[0].message, "upgraded");
+    BOOST_CHECK(events[0].isNotFound);
+}
+
+BOOST_AUTO_TEST_CASE(check_failure) {
+    std::vector<std::type_info const*> types;
+    std::size_t id = pexExcept::addExceptionObserver(
+            [&types](pexExcept::Exception const&, pexExcept::Tracepoint const& tp, pexExcept::ExceptionEvent) {
+                types.push_back(tp._site->_type);
+            });
+    BOOST_CHECK_THROW(LSST_CHECK(false, pexExcept::NotFoundError, "missing"), pexExcept::NotFoundError);
+    BOOST_CHECK(pexExcept::removeExceptionObserver(id));
+    BOOST_REQUIRE_EQUAL(types.size(), 1u);
+    BOOST_CHECK(types[0] == &typeid(pexExcept::NotFoundError));
+}
+
+BOOST_AUTO_TEST_CASE(remove_unknown) {
+    BOOST_CHECK(!pexExcept::removeExceptionObserver(0));
+    BOOST_CHECK_THROW(pexExcept::addExceptionObserver(pexExcept::ExceptionObserver()),
+                      pexExcept::InvalidParameterError);
+}
+
+BOOST_AUTO_TEST_CASE(observer_throws_and_nests) {
+    int calls = 0;
+    std::size_t id = pexExcept::addExceptionObserver(
+            [&calls](pexExcept::Exception const&, pexExcept::Tracepoint const&, pexExcept::ExceptionEvent) {
+                ++calls;
+                throw LSST_EXCEPT(pexExcept::LogicError, "from observer");  // neither observed nor thrown
+            });
+    pexExcept::RuntimeError e = LSST_EXCEPT(pexExcept::RuntimeError, "observed");
+    BOOST_CHECK_EQUAL(e.what(), "observed");
+    BOOST_CHECK_EQUAL(calls, 1);
+    BOOST_CHECK(pexExcept::removeExceptionObserver(id));
+}
+
+BOOST_AUTO_TEST_CASE(register_while_throwing) {
+    std::atomic<bool> stop(false);
+    std::atomic<long> observed(0);
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 4; ++i) {
+        threads.emplace_back([&stop]() {
+            while (!stop.load()) {
+                try {
+                    throw LSST_EXCEPT(pexExcept::RuntimeError, "busy");
+                } catch (pexExcept::RuntimeError const&) {
+                }
+            }
+        });
+    }
+    for (int i = 0; i < 1000; ++i) {
+        std::size_t id = pexExcept::addExceptionObserver(
+                [&observed](pexExcept::Exception const&, pexExcept::Tracepoint const&,
+                            pexExcept::ExceptionEvent) { ++observed; });
+        std::this_thread::yield();
+        BOOST_CHECK(pexExcept::removeExceptionObserver(id));
+    }
+    stop = true;
+    for (auto& thread : threads) thread.join();
+    long const total = observed.load();
+    pexExcept::RuntimeError e = LSST_EXCEPT(pexExcept::RuntimeError, "idle");
+    BOOST_CHECK_EQUAL(observed.load(), total);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,129 @@
+/*
+ * This file is part of pex_exceptions.
+ *
+ * Developed for the LSST Data Management System.
+ * This product includes software developed by the LSST Project
+ * (https://www.lsst.org).
+ * See the COPYRIGHT file at the top-level directory of this distribution
+ * for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <set>
+#include <string>
+#include <vector>
+
+#if defined(__linux__)
+#include <elf.h>
+#endif
+
+#include "lsst/pex/exceptions/Probes.h"
+
+#define BOOST_TEST_MODULE Probes
+#define BOOST_TEST_DYN_LINK
+#include "boost/test/unit_test.hpp"
+
+namespace pexExcept = lsst::pex::exceptions;
+
+#if defined(__linux__)
+namespace {
+
+// Return the path of the loaded libpex_exceptions shared library, from /proc/self/maps.
+std::string findLibrary() {
+    std::ifstream maps("/proc/self/maps");
+    std::string line;
+    while (std::getline(maps, line)) {
+        std::size_t const start = line.find('/');
+        if (start != std::string::npos && line.find("libpex_exceptions", start) != std::string::npos) {
+            return line.substr(start);
+        }
+    }
+    return std::string();
+}
+
+// Return "provider:name args" for each USDT probe note in a 64-bit ELF file.
+std::set<std::string> readProbes(std::string const& path) {
+    std::ifstream file(path, std::ios::binary);
+    std::vector<char> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    std::set<std::string> result;
+    BOOST_REQUIRE_GE(data.size(), sizeof(Elf64_Ehdr));
+    Elf64_Ehdr header;
+    std::memcpy(&header, data.data(), sizeof(header));
+    BOOST_REQUIRE_EQUAL(std::memcmp(header.e_ident, ELFMAG, SELFMAG), 0);
+    if (header.e_ident[EI_CLASS] != ELFCLASS64) return result;
+    std::vector<Elf64_Shdr> sections(header.e_shnum);
+    BOOST_REQUIRE_LE(header.e_shoff + header.e_shnum * sizeof(Elf64_Shdr), data.size());
+    std::memcpy(sections.data(), data.data() + header.e_shoff, header.e_shnum * sizeof(Elf64_Shdr));
+    char const* names = data.data() + sections.at(header.e_shstrndx).sh_offset;
+    for (Elf64_Shdr const& section : sections) {
+        if (section.sh_type != SHT_NOTE || std::strcmp(names + section.sh_name, ".note.stapsdt") != 0) {
+            continue;
+        }
+        std::size_t offset = section.sh_offset;
+        std::size_t const end = offset + section.sh_size;
+        while (offset + sizeof(Elf64_Nhdr) <= end) {
+            Elf64_Nhdr note;
+            std::memcpy(&note, data.data() + offset, sizeof(note));
+            char const* name = data.data() + offset + sizeof(note);
+            char const* desc = name + ((note.n_namesz + 3) & ~3u);
+            if (note.n_type == 3 && std::strcmp(name, "stapsdt") == 0) {
+                char const* provider = desc + 3 * sizeof(Elf64_Addr);  // after pc, base and semaphore
+                char const* probe = provider + std::strlen(provider) + 1;
+                char const* args = probe + std::strlen(probe) + 1;
+                result.insert(std::string(provider) + ":" + probe + " " + args);
+            }
+            offset = desc + ((note.n_descsz + 3) & ~3u) - data.data();
+        }
+    }
+    return result;
+}
+
+// Return the number of space-separated arguments in the description of a probe.
+int countArguments(std::string const& probe) {
+    int count = 0;
+    for (std::size_t i = probe.find(' '); i != std::string::npos; i = probe.find(' ', i + 1)) ++count;
+    return count;
+}
+
+}  // namespace
+#endif
+
+BOOST_AUTO_TEST_SUITE(ProbesSuite)
+
+BOOST_AUTO_TEST_CASE(notes) {
+#if defined(__linux__)
+    std::string const path = findLibrary();
+    BOOST_REQUIRE(!path.empty());
+    std::set<std::string> const probes = readProbes(path);
+    std::set<std::string> names;
+    for (std::string const& probe : probes) {
+        names.insert(probe.substr(0, probe.find(' ')));
+        BOOST_CHECK_EQUAL(countArguments(probe), 5);
+    }
+    if (pexExcept::hasExceptionProbes()) {
+        BOOST_CHECK_EQUAL(names.count("lsst_pex_exceptions:created"), 1u);
+        BOOST_CHECK_EQUAL(names.count("lsst_pex_exceptions:message_added"), 1u);
+    } else {
+        BOOST_CHECK(names.empty());
+    }
+#else
+    BOOST_TEST_MESSAGE("USDT probes are only checked on Linux");
+#endif
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,91 @@
+/*
+ * This file is part of pex_exceptions.
+ *
+ * Developed for the LSST Data Management System.
+ * This product includes software developed by the LSST Project
+ * (https://www.lsst.org).
+ * See the COPYRIGHT file at the top-level directory of this distribution
+ * for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "lsst/pex/exceptions/Runtime.h"
+#include "lsst/pex/exceptions/SiteMap.h"
+
+#define BOOST_TEST_MODULE SiteMap
+#define BOOST_TEST_DYN_LINK
+#include "boost/test/unit_test.hpp"
+
+namespace pexExcept = lsst::pex::exceptions;
+
+namespace {
+
+// Sites as recorded with -DLSST_EXCEPT_SITE_IDS, whichever mode this test is compiled in.
+constexpr pexExcept::TracepointSite mappedSite =
+        pexExcept::TracepointSite::fromId(pexExcept::TracepointSite::hashLocation("src/mapped.cc", 12), 12);
+constexpr pexExcept::TracepointSite unmappedSite = pexExcept::TracepointSite::fromId(0x0123456789abcdef, 34);
+
+std::string format(pexExcept::Exception const &e) {
+    std::ostringstream s;
+    e.addToStream(s);
+    return s.str();
+}
+
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(SiteMapSuite)
+
+BOOST_AUTO_TEST_CASE(lookup) {
+    char path[] = "/tmp/test_SiteMap_XXXXXX";
+    int const fd = mkstemp(path);
+    BOOST_REQUIRE(fd >= 0);
+    close(fd);
+    {
+        std::ofstream map(path);
+        BOOST_REQUIRE(map);
+        map << "# comment\n";
+        map << std::hex << mappedSite._hash << std::dec << "\t12\tsrc/mapped.cc\tvoid mapped(int)\n";
+    }
+    pexExcept::loadSiteMap(path);
+    std::remove(path);
+
+    pexExcept::RuntimeError e(&mappedSite, "mapped");
+    BOOST_CHECK_EQUAL(e.getTraceback()[0].getFile(), "src/mapped.cc");
+    BOOST_CHECK_EQUAL(e.getTraceback()[0].getFunction(), "void mapped(int)");
+    BOOST_CHECK_EQUAL(format(e),
+                      "\n"
+                      "  File \"src/mapped.cc\", line 12, in void mapped(int)\n"
+                      "    mapped {0}\n"
+                      "lsst::pex::exceptions::RuntimeError: 'mapped'\n");
+
+    e.addMessage(&unmappedSite, "unmapped");
+    BOOST_CHECK_EQUAL(e.getTraceback()[1].getFile(), "<site 0x0123456789abcdef>");
+    BOOST_CHECK_EQUAL(e.getTraceback()[1].getFunction(), "<unknown>");
+    BOOST_CHECK_EQUAL(e.getTraceback()[1].getLine(), 34);
+}
+
+BOOST_AUTO_TEST_CASE(missing) {
+    BOOST_CHECK_THROW(pexExcept::loadSiteMap("/nonexistent/test_SiteMap.sites"), pexExcept::IoError);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
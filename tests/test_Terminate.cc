@@ -0,0 +1,182 @@
+/*
+ * This file is part of pex_exceptions.
+ *
+ * Developed for the LSST Data Management System.
+ * This product includes software developed by the LSST Project
+ * (https://www.lsst.org).
+ * See the COPYRIGHT file at the top-level directory of this distribution
+ * for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <csignal>
+#include <stdexcept>
+#include <string>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "boost/format.hpp"
+
+#include "lsst/pex/exceptions/Runtime.h"
+#include "lsst/pex/exceptions/Terminate.h"
+
+#define BOOST_TEST_MODULE Terminate
+#define BOOST_TEST_DYN_LINK
+#include "boost/test/unit_test.hpp"
+
+namespace pexExcept = lsst::pex::exceptions;
+
+namespace {
+
+// Return the file shown for a site on `line` of this file; in site ID mode, without a site map, only the
+// site's ID is known.
+std::string siteFile([[maybe_unused]] int line) {
+#if defined(LSST_EXCEPT_SITE_IDS)
+    return (boost::format("<site 0x%016x>") % pexExcept::TracepointSite::hashLocation(__FILE__, line)).str();
+#else
+    return __FILE__;
+#endif
+}
+
+// Return everything written to a pipe until it is closed.
+std::string readAll(int fd) {
+    std::string result;
+    char buffer[4096];
+    ssize_t n;
+    while ((n = ::read(fd, buffer, sizeof(buffer))) > 0) result.append(buffer, n);
+    ::close(fd);
+    return result;
+}
+
+// Return what writeCurrentException writes while handling `e`.
+template <typename E>
+std::string report(E const& e) {
+    int fds[2];
+    BOOST_REQUIRE_EQUAL(::pipe(fds), 0);
+    try {
+        throw e;
+    } catch (...) {
+        BOOST_CHECK(pexExcept::writeCurrentException(fds[1], "header:"));
+    }
+    ::close(fds[1]);
+    return readAll(fds[0]);
+}
+
+int const FAIL_LINE = __LINE__ + 1;
+void fail() { throw LSST_EXCEPT(pexExcept::NotFoundError, "escaped"); }
+
+void failFromNoexcept() noexcept { fail(); }
+
+// Run `body` in a child process with its standard error sent to a pipe; return the output and status.
+template <typename F>
+std::string runChild(F body, int& status) {
+    int fds[2];
+    BOOST_REQUIRE_EQUAL(::pipe(fds), 0);
+    pid_t pid = ::fork();
+    BOOST_REQUIRE(pid >= 0);
+    if (pid == 0) {
+        ::close(fds[0]);
+        ::dup2(fds[1], STDERR_FILENO);
+        // Boost.Test's own handlers would resume the test suite in the child.
+        std::signal(SIGABRT, SIG_DFL);
+        std::signal(SIGSEGV, SIG_DFL);
+        body();
+        ::_exit(0);
+    }
+    ::close(fds[1]);
+    std::string output = readAll(fds[0]);
+    ::waitpid(pid, &status, 0);
+    return output;
+}
+
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(TerminateSuite)
+
+BOOST_AUTO_TEST_CASE(no_current_exception) {
+    BOOST_CHECK(!pexExcept::writeCurrentException(STDERR_FILENO));
+}
+
+BOOST_AUTO_TEST_CASE(lsst_exception) {
+    int const line = __LINE__ + 1;
+    pexExcept::RuntimeError e = LSST_EXCEPT(pexExcept::RuntimeError, "first");
+    LSST_EXCEPT_ADD(e, "second");
+    std::string const expected = std::string("header:\n  File \"") + siteFile(line) + "\", line " +
+                                 std::to_string(line) + ", in ";
+    std::string const output = report(e);
+    BOOST_CHECK_EQUAL(output.substr(0, expected.size()), expected);
+    BOOST_CHECK(output.find("\n    first {0}\n") != std::string::npos);
+    BOOST_CHECK(output.find("\n    second {1}\n") != std::string::npos);
+    BOOST_CHECK(output.find("\nlsst::pex::exceptions::RuntimeError: 'first {0}; second {1}'\n") !=
+                std::string::npos);
+}
+
+BOOST_AUTO_TEST_CASE(cause_and_other_exceptions) {
+    std::string output = report(LSST_EXCEPT_FROM(pexExcept::RuntimeError,
+                                                 std::make_exception_ptr(std::out_of_range("index")),
+                                                 "lookup failed"));
+    BOOST_CHECK(output.find("'lookup failed'\nCaused by: St12out_of_range: index\n") != std::string::npos);
+
+    output = report(pexExcept::LogicError("from Python"));
+    BOOST_CHECK_EQUAL(output, "header: lsst::pex::exceptions::LogicError: from Python\n");
+
+    output = report(42);
+    BOOST_CHECK_EQUAL(output, "header: exception of type i\n");
+}
+
+BOOST_AUTO_TEST_CASE(truncated) {
+    std::string const message(2 * pexExcept::TERMINATE_REPORT_CAPACITY, 'x');
+    std::string const output = report(LSST_EXCEPT(pexExcept::RuntimeError, message));
+    BOOST_CHECK_EQUAL(output.size(), pexExcept::TERMINATE_REPORT_CAPACITY);
+    BOOST_CHECK_EQUAL(output.substr(output.size() - 20), "\n[report truncated]\n");
+}
+
+BOOST_AUTO_TEST_CASE(terminate_handler) {
+    int status = 0;
+    std::string const output = runChild(
+            []() {
+                pexExcept::installTerminateHandler();
+                pexExcept::installTerminateSignalHandlers();
+                failFromNoexcept();
+            },
+            status);
+    BOOST_CHECK(WIFSIGNALED(status) && WTERMSIG(status) == SIGABRT);
+    std::string const expected = "terminate called after throwing:\n  File \"" + siteFile(FAIL_LINE) +
+                                 "\", line " + std::to_string(FAIL_LINE);
+    BOOST_CHECK_EQUAL(output.substr(0, expected.size()), expected);
+    BOOST_CHECK(output.find("lsst::pex::exceptions::NotFoundError: 'escaped'\n") != std::string::npos);
+    // Reported once, although the abort that follows goes through the signal handler.
+    BOOST_CHECK_EQUAL(output.find("escaped'"), output.rfind("escaped'"));
+}
+
+BOOST_AUTO_TEST_CASE(signal_handler) {
+    int status = 0;
+    std::string const output = runChild(
+            []() {
+                pexExcept::installTerminateSignalHandlers();
+                try {
+                    throw LSST_EXCEPT(pexExcept::RuntimeError, "handling");
+                } catch (pexExcept::RuntimeError const&) {
+                    ::raise(SIGSEGV);
+                }
+            },
+            status);
+    BOOST_CHECK(WIFSIGNALED(status) && WTERMSIG(status) == SIGSEGV);
+    BOOST_CHECK(output.find("fatal signal received while handling:\n") == 0);
+    BOOST_CHECK(output.find("lsst::pex::exceptions::RuntimeError: 'handling'\n") != std::string::npos);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
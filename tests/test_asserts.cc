@@ -0,0 +1,205 @@
+/*
+ * This file is part of pex_exceptions.
+ *
+ * Developed for the LSST Data Management System.
+ * This product includes software developed by the LSST Project
+ * (https://www.lsst.org).
+ * See the COPYRIGHT file at the top-level directory of this distribution
+ * for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <cstddef>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "boost/format.hpp"
+
+#include "lsst/pex/exceptions/asserts.h"
+
+#define BOOST_TEST_MODULE asserts
+#define BOOST_TEST_DYN_LINK
+#include "boost/test/unit_test.hpp"
+
+namespace pexExcept = lsst::pex::exceptions;
+
+namespace {
+
+struct Shape {
+    int width;
+    int height;
+};
+
+std::ostream& operator<<(std::ostream& stream, Shape const& shape) {
+    return stream << shape.width << "x" << shape.height;
+}
+
+bool operator!=(Shape const& a, Shape const& b) { return a.width != b.width || a.height != b.height; }
+
+enum Color { RED, GREEN };
+
+// Return the file shown for a site on `line` of this file; in site ID mode, without a site map, only the
+// site's ID is known.
+std::string siteFile([[maybe_unused]] int line) {
+#if defined(LSST_EXCEPT_SITE_IDS)
+    return (boost::format("<site 0x%016x>") % pexExcept::TracepointSite::hashLocation(__FILE__, line)).str();
+#else
+    return __FILE__;
+#endif
+}
+
+// Return the message thrown by LSST_THROW_IF_NE(n1, n2, ...) with the given format.
+template <typename T1, typename T2>
+std::string formatted(char const* format, T1 const& n1, T2 const& n2) {
+    try {
+        LSST_THROW_IF_NE(n1, n2, pexExcept::LengthError, format);
+    } catch (pexExcept::LengthError const& e) {
+        return e.what();
+    }
+    return "not thrown";
+}
+
+// Checks in constexpr functions; these must compile away when evaluated with passing constants.
+int const CHECKED_AREA_NE_LINE = __LINE__ + 3;  // the line of the LSST_THROW_IF_NE below
+constexpr int checkedArea(int width, int height) {
+    LSST_THROW_IF_LT(width, 0, pexExcept::RangeError, "width (%d) is less than %d");
+    LSST_THROW_IF_NE(width, height, pexExcept::LengthError, "width (%d) is not equal to height (%d)");
+    return width * height;
+}
+
+constexpr int checkedElement(int const* values, int size, int index) {
+    LSST_CHECK_NOT_NULL(values, pexExcept::InvalidParameterError, "no values");
+    LSST_CHECK_INDEX(index, size);
+    LSST_CHECK(values[index] % 2 == 1, pexExcept::InvalidParameterError, "element must be odd");
+    return values[index];
+}
+
+constexpr int ODD[] = {1, 3, 5};
+
+static_assert(checkedArea(3, 3) == 9, "checkedArea");
+static_assert(checkedElement(ODD, 3, 2) == 5, "checkedElement");
+
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(AssertsSuite)
+
+BOOST_AUTO_TEST_CASE(comparisons) {
+    BOOST_CHECK_NO_THROW(LSST_THROW_IF_NE(3, 3, pexExcept::LengthError, "%d != %d"));
+    BOOST_CHECK_THROW(LSST_THROW_IF_NE(3, 4, pexExcept::LengthError, "%d != %d"), pexExcept::LengthError);
+    BOOST_CHECK_NO_THROW(LSST_THROW_IF_EQ(3, 4, pexExcept::LengthError, "%d == %d"));
+    BOOST_CHECK_THROW(LSST_THROW_IF_EQ(4, 4, pexExcept::LengthError, "%d == %d"), pexExcept::LengthError);
+    BOOST_CHECK_NO_THROW(LSST_THROW_IF_LT(4, 4, pexExcept::RangeError, "%d < %d"));
+    BOOST_CHECK_THROW(LSST_THROW_IF_LT(3, 4, pexExcept::RangeError, "%d < %d"), pexExcept::RangeError);
+    BOOST_CHECK_NO_THROW(LSST_THROW_IF_LE(5, 4, pexExcept::RangeError, "%d <= %d"));
+    BOOST_CHECK_THROW(LSST_THROW_IF_LE(4, 4, pexExcept::RangeError, "%d <= %d"), pexExcept::RangeError);
+    BOOST_CHECK_NO_THROW(LSST_THROW_IF_GT(4, 4, pexExcept::RangeError, "%d > %d"));
+    BOOST_CHECK_THROW(LSST_THROW_IF_GT(5, 4, pexExcept::RangeError, "%d > %d"), pexExcept::RangeError);
+    BOOST_CHECK_NO_THROW(LSST_THROW_IF_GE(3, 4, pexExcept::RangeError, "%d >= %d"));
+    BOOST_CHECK_THROW(LSST_THROW_IF_GE(4, 4, pexExcept::RangeError, "%d >= %d"), pexExcept::RangeError);
+}
+
+BOOST_AUTO_TEST_CASE(message) {
+    int const line = __LINE__ + 2;
+    try {
+        LSST_THROW_IF_NE(3, 4, pexExcept::LengthError, "size of foo (%d) is not equal to size of bar (%d)");
+        BOOST_FAIL("Expected LengthError not thrown");
+    } catch (pexExcept::LengthError const& e) {
+        BOOST_CHECK_EQUAL(e.what(), "size of foo (3) is not equal to size of bar (4)");
+        BOOST_REQUIRE_EQUAL(e.getTraceback().size(), 1u);
+        BOOST_CHECK_EQUAL(e.getTraceback()[0].getFile(), siteFile(line));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(single_evaluation) {
+    int count = 0;
+    BOOST_CHECK_THROW(LSST_THROW_IF_NE(++count, 5, pexExcept::LengthError, "%d != %d"),
+                      pexExcept::LengthError);
+    BOOST_CHECK_EQUAL(count, 1);
+}
+
+BOOST_AUTO_TEST_CASE(check_index) {
+    std::vector<double> v(3);
+    BOOST_CHECK_NO_THROW(LSST_CHECK_INDEX(0, v.size()));
+    BOOST_CHECK_NO_THROW(LSST_CHECK_INDEX(2, v.size()));
+    BOOST_CHECK_THROW(LSST_CHECK_INDEX(3, v.size()), pexExcept::OutOfRangeError);
+    BOOST_CHECK_THROW(LSST_CHECK_INDEX(-1, v.size()), pexExcept::OutOfRangeError);
+    BOOST_CHECK_THROW(LSST_CHECK_INDEX(0u, 0), pexExcept::OutOfRangeError);
+    try {
+        LSST_CHECK_INDEX(7, v.size());
+    } catch (pexExcept::OutOfRangeError const& e) {
+        BOOST_CHECK_EQUAL(e.what(), "Index 7 out of range for size 3");
+    }
+}
+
+BOOST_AUTO_TEST_CASE(check_not_null) {
+    std::shared_ptr<int> empty;
+    auto full = std::make_shared<int>(1);
+    int const* raw = nullptr;
+    BOOST_CHECK_NO_THROW(LSST_CHECK_NOT_NULL(full, pexExcept::InvalidParameterError, "null"));
+    BOOST_CHECK_THROW(LSST_CHECK_NOT_NULL(empty, pexExcept::InvalidParameterError, "null"),
+                      pexExcept::InvalidParameterError);
+    BOOST_CHECK_THROW(LSST_CHECK_NOT_NULL(raw, pexExcept::InvalidParameterError, "null"),
+                      pexExcept::InvalidParameterError);
+}
+
+BOOST_AUTO_TEST_CASE(check) {
+    BOOST_CHECK_NO_THROW(LSST_CHECK(5 % 2 == 1, pexExcept::InvalidParameterError, "must be odd"));
+    try {
+        LSST_CHECK(4 % 2 == 1, pexExcept::InvalidParameterError, "must be odd");
+        BOOST_FAIL("Expected InvalidParameterError not thrown");
+    } catch (pexExcept::InvalidParameterError const& e) {
+        BOOST_CHECK_EQUAL(e.what(), "must be odd");
+    }
+}
+
+BOOST_AUTO_TEST_CASE(formatting) {
+    BOOST_CHECK_EQUAL(formatted("%d != %d", -3, 4L), "-3 != 4");
+    BOOST_CHECK_EQUAL(formatted("%d != %d", 18446744073709551615ULL, 0ULL), "18446744073709551615 != 0");
+    BOOST_CHECK_EQUAL(formatted("%.2f != %g", 1.5, 0.25f), "1.50 != 0.25");
+    BOOST_CHECK_EQUAL(formatted("%x != %05d", 255, 42L), "ff != 00042");
+    BOOST_CHECK_EQUAL(formatted("'%s' != '%s'", 'a', 'b'), "'a' != 'b'");
+    BOOST_CHECK_EQUAL(formatted("%s != %s", std::string("abc"), std::string("abd")), "abc != abd");
+    BOOST_CHECK_EQUAL(formatted("%s != %s", "abc", "xyz"), "abc != xyz");
+    BOOST_CHECK_EQUAL(formatted("%d != %d", RED, GREEN), "0 != 1");
+    BOOST_CHECK_EQUAL(formatted("%d != %d", true, false), "1 != 0");
+    BOOST_CHECK_EQUAL(formatted("%1% != %2%", Shape{3, 4}, Shape{4, 3}), "3x4 != 4x3");
+}
+
+BOOST_AUTO_TEST_CASE(constexpr_runtime) {
+    int width = 3;
+    int const even[] = {2, 4};
+    BOOST_CHECK_EQUAL(checkedArea(width, 3), 9);
+    BOOST_CHECK_THROW(checkedArea(-width, -width), pexExcept::RangeError);
+    BOOST_CHECK_THROW(checkedElement(nullptr, 0, 0), pexExcept::InvalidParameterError);
+    BOOST_CHECK_THROW(checkedElement(ODD, 3, width), pexExcept::OutOfRangeError);
+    BOOST_CHECK_THROW(checkedElement(even, 2, 0), pexExcept::InvalidParameterError);
+    try {
+        checkedArea(width, 4);
+        BOOST_FAIL("Expected LengthError not thrown");
+    } catch (pexExcept::LengthError const& e) {
+        BOOST_CHECK_EQUAL(e.what(), "width (3) is not equal to height (4)");
+        BOOST_REQUIRE_EQUAL(e.getTraceback().size(), 1u);
+        BOOST_CHECK_EQUAL(e.getTraceback()[0].getFile(), siteFile(CHECKED_AREA_NE_LINE));
+        BOOST_CHECK_EQUAL(e.getTraceback()[0].getLine(), CHECKED_AREA_NE_LINE);
+#ifndef LSST_EXCEPT_SITE_IDS
+        std::string function = e.getTraceback()[0].getFunction();
+        BOOST_CHECK_NE(function.find("checkedArea"), std::string::npos);
+#endif
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,85 @@
+# This file is part of pex_exceptions.
+#
+# Developed for the LSST Data Management System.
+# This product includes software developed by the LSST Project
+# (https://www.lsst.org).
+# See the COPYRIGHT file at the top-level directory of this distribution
+# for details of code ownership.
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+"""Check that the check macros of asserts.h stop compilation when they fail in constant expressions.
+
+Each source in compileFail/ must compile when LSST_COMPILE_FAIL_CONTROL is defined, and must fail to
+compile, with an error mentioning each of its ``// EXPECTED:`` lines, when it is not.
+"""
+
+import glob
+import os
+import shlex
+import shutil
+import subprocess
+import unittest
+
+TESTDIR = os.path.abspath(os.path.dirname(__file__))
+SOURCES = sorted(glob.glob(os.path.join(TESTDIR, "compileFail", "*.cc")))
+
+
+def findCompiler():
+    """Return the command for the C++ compiler, or None if there is none."""
+    command = shlex.split(os.environ.get("CXX", "c++"))
+    if command and shutil.which(command[0]):
+        return command
+    return None
+
+
+def compileSource(compiler, source, *flags):
+    """Compile ``source`` without generating code, returning the process."""
+    includes = [os.path.join(TESTDIR, os.pardir, "include")]
+    for product in ("BASE_DIR", "BOOST_DIR"):
+        if product in os.environ:
+            includes.append(os.path.join(os.environ[product], "include"))
+    command = compiler + ["-std=c++17", "-fsyntax-only"] + ["-I" + path for path in includes]
+    return subprocess.run(command + list(flags) + [source], stdout=subprocess.PIPE,
+                          stderr=subprocess.STDOUT, universal_newlines=True)
+
+
+@unittest.skipIf(findCompiler() is None, "no C++ compiler found")
+class CompileFailTestCase(unittest.TestCase):
+    """A test case for checks that fail during constant evaluation."""
+
+    def setUp(self):
+        self.compiler = findCompiler()
+
+    def testSourcesFound(self):
+        self.assertGreater(len(SOURCES), 0)
+
+    def testCompileFail(self):
+        for source in SOURCES:
+            with self.subTest(source=os.path.basename(source)):
+                with open(source) as stream:
+                    expected = [line.split(":", 1)[1].strip() for line in stream
+                                if line.startswith("// EXPECTED:")]
+                self.assertGreater(len(expected), 0)
+                control = compileSource(self.compiler, source, "-DLSST_COMPILE_FAIL_CONTROL")
+                self.assertEqual(control.returncode, 0, control.stdout)
+                result = compileSource(self.compiler, source)
+                self.assertNotEqual(result.returncode, 0)
+                for text in expected:
+                    self.assertIn(text, result.stdout)
+
+
+if __name__ == '__main__':
+    unittest.main()